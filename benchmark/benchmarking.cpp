@@ -1,8 +1,45 @@
 #include <benchmark/benchmark.h>
 #include "wilderfield/priority_map.hpp"  // Include your wilderfield::priority_map implementation
+#include "wilderfield/interned_priority_map.hpp"
+#include "wilderfield/perfect_hash_map.hpp"
+#include "wilderfield/hot_cache_map.hpp"
+#include "wilderfield/incremental_hash_map.hpp"
+#include "wilderfield/huge_page_allocator.hpp"
+#include "wilderfield/sharded_priority_map.hpp"
+#include "wilderfield/priority_map_builder.hpp"
+#include "wilderfield/priority_scheduler.hpp"
+#include "wilderfield/frozen_priority_map.hpp"
+#include "wilderfield/algorithms/core_decomposition.hpp"
+#include "wilderfield/algorithms/topological_sort.hpp"
+#include "wilderfield/algorithms/dijkstra.hpp"
+#include "wilderfield/algorithms/minimum_degree.hpp"
+#include "wilderfield/algorithms/dsatur.hpp"
+#include "wilderfield/algorithms/set_cover.hpp"
+#include "wilderfield/algorithms/huffman.hpp"
+#include "wilderfield/algorithms/level_scheduler.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <list>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 static void BM_InsertZeroRef(benchmark::State& state) {
 
@@ -61,6 +98,67 @@ static void BM_Index(benchmark::State& state) {
 
 BENCHMARK(BM_Index)->Range(8, 8<<10);
 
+static void BM_Get(benchmark::State& state) {
+    wilderfield::priority_map<int, int> pmap;
+
+    for (int i = 0; i < state.range(0); ++i) {
+        pmap[i] = i; // Insert elements into the map
+    }
+
+    for (auto _ : state) {
+        // This code gets timed
+        for (int i = 0; i < state.range(0); ++i) {
+            benchmark::DoNotOptimize(pmap.get(i)); // Read priorities without inserting
+        }
+    }
+}
+
+BENCHMARK(BM_Get)->Range(8, 8<<10);
+
+static void BM_FrozenValue(benchmark::State& state) {
+    wilderfield::priority_map_builder<int, int> builder;
+    for (int i = 0; i < state.range(0); ++i) {
+        builder[i] = i % 64; // Few distinct values, like counters
+    }
+    auto frozen = wilderfield::freeze(builder.finalize());
+
+    for (auto _ : state) {
+        // This code gets timed
+        for (int i = 0; i < state.range(0); ++i) {
+            benchmark::DoNotOptimize(frozen.value(i));
+        }
+    }
+
+    state.counters["bytes_per_key"] = double(frozen.memory_bytes()) / double(frozen.size());
+}
+
+BENCHMARK(BM_FrozenValue)->Range(8, 8<<10);
+
+static void BM_IndexInsert(benchmark::State& state) {
+    wilderfield::priority_map<int, int> pmap;
+
+    for (int i = 0; i < state.range(0); ++i) {
+        pmap[i] = i; // Insert elements into the map
+    }
+
+    for (auto _ : state) {
+        // This code gets timed
+        for (int i = 0; i < state.range(0); ++i) {
+            int val = pmap[-1 - i]; // Read missing keys, inserting them at 0
+            benchmark::DoNotOptimize(val);
+        }
+
+        // Remove the inserted keys for the next iteration
+        state.PauseTiming();
+        for (int i = 0; i < state.range(0); ++i) {
+            pmap.erase(-1 - i);
+        }
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(BM_IndexInsert)->Range(8, 8<<10);
+
 static void BM_Increment(benchmark::State& state) {
     wilderfield::priority_map<int, int> pmap;
 
@@ -107,6 +205,35 @@ static void BM_Decrement(benchmark::State& state) {
 
 BENCHMARK(BM_Decrement)->Range(8, 8<<10);
 
+static void BM_IncrementPerfectHash(benchmark::State& state) {
+    using pmap_type = wilderfield::priority_map<int, int, std::greater<int>, std::hash<int>, wilderfield::perfect_hash_map>;
+
+    std::vector<int> keys(state.range(0));
+    for (int i = 0; i < state.range(0); ++i) {
+        keys[i] = i;
+    }
+    pmap_type pmap(pmap_type::key_index_type(keys.begin(), keys.end()));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int i = 0; i < state.range(0); ++i) {
+            pmap[i] = 0; // Insert elements into the map
+        }
+        state.ResumeTiming();
+        // This code gets timed
+        for (int i = 0; i < state.range(0); ++i) {
+            ++pmap[i]; // Increment priorities
+        }
+
+        // Clear the map for the next iteration
+        state.PauseTiming();
+        while(!pmap.empty()) pmap.pop();
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(BM_IncrementPerfectHash)->Range(8, 8<<10);
+
 static void BM_TopPop(benchmark::State& state) {
     wilderfield::priority_map<int, int> pmap;
 
@@ -125,6 +252,1021 @@ static void BM_TopPop(benchmark::State& state) {
 
 BENCHMARK(BM_TopPop)->Range(8, 8<<10);
 
+// Long URL keys, each referenced several times
+static std::vector<std::string> makeUrls(int n) {
+    std::vector<std::string> urls;
+    for (int i = 0; i < n; ++i) {
+        urls.push_back("https://static.example.com/assets/images/gallery/2024/collection-" + std::to_string(i % (n / 4 + 1)) + "/thumbnail.png");
+    }
+    return urls;
+}
+
+static void BM_StringKeys(benchmark::State& state) {
+    auto urls = makeUrls(state.range(0));
+
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::priority_map<std::string, int> pmap;
+        for (const auto& url : urls) {
+            ++pmap[url]; // Count urls
+        }
+        benchmark::DoNotOptimize(pmap.top());
+    }
+}
+
+BENCHMARK(BM_StringKeys)->Range(8, 8<<10);
+
+static void BM_InternedKeys(benchmark::State& state) {
+    auto urls = makeUrls(state.range(0));
+
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::interned_priority_map<int> pmap;
+        for (const auto& url : urls) {
+            ++pmap[url]; // Count urls
+        }
+        benchmark::DoNotOptimize(pmap.top());
+    }
+}
+
+BENCHMARK(BM_InternedKeys)->Range(8, 8<<10);
+
+// Keys drawn from a Zipf distribution over [0, universe)
+static std::vector<int> makeZipfKeys(int count, int universe, double alpha) {
+    std::vector<double> weights(universe);
+    for (int k = 0; k < universe; ++k) {
+        weights[k] = 1.0 / std::pow(k + 1, alpha);
+    }
+    std::mt19937 gen(42);
+    std::discrete_distribution<int> dist(weights.begin(), weights.end());
+    std::vector<int> keys(count);
+    for (auto& key : keys) {
+        key = dist(gen);
+    }
+    return keys;
+}
+
+static void BM_ZipfIncrement(benchmark::State& state) {
+    auto keys = makeZipfKeys(state.range(0), 1 << 16, 1.1);
+
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::priority_map<int, int> pmap;
+        for (auto key : keys) {
+            ++pmap[key]; // Increment skewed keys
+        }
+        benchmark::DoNotOptimize(pmap.top());
+    }
+}
+
+BENCHMARK(BM_ZipfIncrement)->Range(8<<4, 8<<12);
+
+static void BM_ZipfIncrementHotCache(benchmark::State& state) {
+    using pmap_type = wilderfield::priority_map<int, int, std::greater<int>, std::hash<int>, wilderfield::hot_cache_map>;
+
+    auto keys = makeZipfKeys(state.range(0), 1 << 16, 1.1);
+    double hitRate = 0;
+
+    for (auto _ : state) {
+        // This code gets timed
+        pmap_type pmap;
+        for (auto key : keys) {
+            ++pmap[key]; // Increment skewed keys
+        }
+        benchmark::DoNotOptimize(pmap.top());
+        hitRate = pmap.key_index().hit_rate();
+    }
+
+    state.counters["hit_rate"] = hitRate;
+}
+
+BENCHMARK(BM_ZipfIncrementHotCache)->Range(8<<4, 8<<12);
+
+static void BM_ZipfIncrementMany(benchmark::State& state) {
+    auto keys = makeZipfKeys(state.range(0), 1 << 16, 1.1);
+
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::priority_map<int, int> pmap;
+        pmap.increment_many(keys.begin(), keys.end()); // Repeated keys are summed per block
+        benchmark::DoNotOptimize(pmap.top());
+    }
+}
+
+BENCHMARK(BM_ZipfIncrementMany)->Range(8<<4, 8<<12);
+
+// Same counts as BM_ZipfIncrement, ordered once at the end
+static void BM_ZipfCountFinalize(benchmark::State& state) {
+    auto keys = makeZipfKeys(state.range(0), 1 << 16, 1.1);
+
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::priority_map_builder<int, int> builder;
+        for (auto key : keys) {
+            ++builder[key]; // Plain counter increment
+        }
+        auto pmap = builder.finalize(1);
+        benchmark::DoNotOptimize(pmap.top());
+    }
+}
+
+BENCHMARK(BM_ZipfCountFinalize)->Range(8<<4, 8<<12);
+
+// Times every insertion at 0 into a growing map and reports the slowest and the mean
+template<typename Map>
+static void BM_GrowthMaxLatency(benchmark::State& state) {
+    double maxNs = 0;
+    double totalNs = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        Map map;
+        for (int i = 0; i < state.range(0); ++i) {
+            auto start = std::chrono::steady_clock::now();
+            map[i];
+            auto stop = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+            maxNs = std::max(maxNs, ns);
+            totalNs += ns;
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+
+    state.counters["max_insert_ns"] = maxNs;
+    state.counters["mean_insert_ns"] = totalNs / static_cast<double>(state.iterations() * state.range(0));
+}
+
+using IncrementalPriorityMap = wilderfield::priority_map<int, int, std::greater<int>, std::hash<int>, wilderfield::incremental_hash_map>;
+
+BENCHMARK_TEMPLATE(BM_GrowthMaxLatency, std::unordered_map<int, int>)->Range(8<<10, 8<<18)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_GrowthMaxLatency, wilderfield::incremental_hash_map<int, int>)->Range(8<<10, 8<<18)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_GrowthMaxLatency, wilderfield::priority_map<int, int>)->Range(8<<10, 8<<18)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_GrowthMaxLatency, IncrementalPriorityMap)->Range(8<<10, 8<<18)->Iterations(1);
+
+// Counts data TLB read misses of the calling thread, or reports -1 where perf events are unavailable
+class DtlbMissCounter {
+    int fd_ = -1;
+
+public:
+    DtlbMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~DtlbMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    void start() {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    double stop() {
+#if defined(__linux__)
+        long long count = 0;
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) == sizeof(count)) {
+                return static_cast<double>(count);
+            }
+        }
+#endif
+        return -1;
+    }
+};
+
+// Increments random keys of a large map, so nearly every access touches a cold page
+template<typename Allocator>
+static void BM_RandomIncrementAllocator(benchmark::State& state) {
+    using pmap_type = wilderfield::priority_map<int, int, std::greater<int>, std::hash<int>,
+        wilderfield::unordered_key_index, Allocator>;
+
+    const int keyCount = static_cast<int>(state.range(0));
+    pmap_type pmap;
+    for (int i = 0; i < keyCount; ++i) {
+        pmap[i] = 0;
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, keyCount - 1);
+    std::vector<int> keys(1 << 16);
+    for (auto& key : keys) {
+        key = dist(gen);
+    }
+
+    DtlbMissCounter counter;
+    double misses = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        counter.start();
+        for (auto key : keys) {
+            ++pmap[key];
+        }
+        double count = counter.stop();
+        misses = count < 0 ? -1 : misses + count;
+    }
+
+    state.counters["dtlb_misses_per_op"] = misses < 0 ? -1 : misses / (double(state.iterations()) * keys.size());
+}
+
+BENCHMARK_TEMPLATE(BM_RandomIncrementAllocator, std::allocator<int>)->Range(8<<10, 8<<20);
+BENCHMARK_TEMPLATE(BM_RandomIncrementAllocator, wilderfield::huge_page_allocator<int>)->Range(8<<10, 8<<20);
+
+// Allocates and frees a batch of list-node sized blocks on every thread, the
+// pattern of node based containers growing and shrinking
+template<typename Allocator>
+static void BM_AllocatorChurn(benchmark::State& state) {
+    Allocator alloc;
+    std::vector<typename Allocator::value_type*> nodes(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        // This code gets timed
+        for (auto& node : nodes) {
+            node = alloc.allocate(3);
+        }
+        benchmark::DoNotOptimize(nodes.data());
+        for (auto node : nodes) {
+            alloc.deallocate(node, 3);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_AllocatorChurn, std::allocator<std::int64_t>)->Arg(1024)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(BM_AllocatorChurn, wilderfield::huge_page_allocator<std::int64_t>)->Arg(1024)->Threads(1)->Threads(4);
+
+// Ingests random increments from one producer per shard, then merges the top 100.
+// An argument of 0 places one shard on each NUMA node, which is a single shard
+// on machines with one node or without libnuma.
+static void BM_ShardedIngest(benchmark::State& state) {
+    using pmap_type = wilderfield::sharded_priority_map<int, int>;
+
+    const std::size_t shards = state.range(0) ? static_cast<std::size_t>(state.range(0)) : pmap_type::numa_nodes();
+    const int updates = 1 << 18;
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, (1 << 16) - 1);
+    std::vector<int> keys(updates);
+    for (auto& key : keys) {
+        key = dist(gen);
+    }
+
+    for (auto _ : state) {
+        // This code gets timed
+        pmap_type pmap(shards);
+        std::vector<std::thread> producers;
+        for (std::size_t t = 0; t < shards; ++t) {
+            producers.emplace_back([&, t] {
+                for (std::size_t i = t; i < keys.size(); i += shards) {
+                    pmap.add(keys[i], 1);
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        benchmark::DoNotOptimize(pmap.top_k(100));
+    }
+
+    state.counters["numa_nodes"] = static_cast<double>(pmap_type::numa_nodes());
+    state.counters["shards"] = static_cast<double>(shards);
+    state.SetItemsProcessed(state.iterations() * updates);
+}
+
+BENCHMARK(BM_ShardedIngest)->Arg(1)->Arg(0)->UseRealTime();
+
+static std::vector<std::pair<int, int>> makeBulkItems(int count) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 1 << 12);
+    std::vector<std::pair<int, int>> items;
+    items.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        items.emplace_back(i, dist(gen));
+    }
+    return items;
+}
+
+// Smaller than the bulk build, assignment walks the value list for every key
+static void BM_AssignBuild(benchmark::State& state) {
+    auto items = makeBulkItems(1 << 16);
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::priority_map<int, int> pmap;
+        for (const auto& [key, val] : items) {
+            pmap[key] = val;
+        }
+        benchmark::DoNotOptimize(pmap.top());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(BM_AssignBuild)->Unit(benchmark::kMillisecond);
+
+// Argument is the thread count of the bulk load
+static void BM_BulkBuild(benchmark::State& state) {
+    auto items = makeBulkItems(1 << 20);
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::priority_map<int, int> pmap(items.begin(), items.end(), state.range(0));
+        benchmark::DoNotOptimize(pmap.top());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(BM_BulkBuild)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Same load with floating point values, grouped by a comparison sort instead of a radix sort
+static void BM_BulkBuildReal(benchmark::State& state) {
+    auto ints = makeBulkItems(1 << 20);
+    std::vector<std::pair<int, double>> items(ints.begin(), ints.end());
+    for (auto _ : state) {
+        // This code gets timed
+        wilderfield::priority_map<int, double> pmap(items.begin(), items.end(), state.range(0));
+        benchmark::DoNotOptimize(pmap.top());
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(BM_BulkBuildReal)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Undirected random graph with edgesPerNode * nodes edges, endpoints skewed towards low ids
+static wilderfield::algorithms::csr_graph makeRandomGraph(std::size_t nodes, std::size_t edgesPerNode) {
+    using node_type = wilderfield::algorithms::csr_graph::node_type;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<std::pair<node_type, node_type>> edges;
+    edges.reserve(nodes * edgesPerNode);
+    while (edges.size() < nodes * edgesPerNode) {
+        auto u = static_cast<node_type>(nodes * dist(gen) * dist(gen));
+        auto v = static_cast<node_type>(nodes * dist(gen));
+        if (u != v) {
+            edges.emplace_back(u, v);
+        }
+    }
+    return wilderfield::algorithms::csr_graph(nodes, edges, true);
+}
+
+static void BM_CoreDecomposition(benchmark::State& state) {
+    auto graph = makeRandomGraph(state.range(0), 8);
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::core_decomposition(graph);
+        benchmark::DoNotOptimize(result.degeneracy);
+    }
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_CoreDecomposition)->RangeMultiplier(8)->Range(1<<11, 1<<17)->Unit(benchmark::kMillisecond);
+
+// Same peel with a binary heap, pushing a new entry per decrement and skipping stale ones
+static void BM_CoreDecompositionHeap(benchmark::State& state) {
+    using node_type = wilderfield::algorithms::csr_graph::node_type;
+    auto graph = makeRandomGraph(state.range(0), 8);
+    const std::size_t n = graph.node_count();
+
+    for (auto _ : state) {
+        // This code gets timed
+        std::vector<std::size_t> degree(n);
+        std::vector<bool> removed(n, false);
+        std::priority_queue<std::pair<std::size_t, node_type>, std::vector<std::pair<std::size_t, node_type>>, std::greater<>> heap;
+        for (node_type u = 0; u < n; ++u) {
+            degree[u] = graph.degree(u);
+            heap.emplace(degree[u], u);
+        }
+        std::size_t k = 0;
+        while (!heap.empty()) {
+            auto [d, u] = heap.top();
+            heap.pop();
+            if (removed[u] || d != degree[u]) {
+                continue; // Stale entry
+            }
+            removed[u] = true;
+            k = std::max(k, d);
+            for (auto v : graph.neighbors(u)) {
+                if (!removed[v]) {
+                    heap.emplace(--degree[v], v);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(k);
+    }
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_CoreDecompositionHeap)->RangeMultiplier(8)->Range(1<<11, 1<<17)->Unit(benchmark::kMillisecond);
+
+// Random DAG with edgesPerNode * nodes edges, each from a lower to a higher id within a window
+static wilderfield::algorithms::csr_graph makeRandomDag(std::size_t nodes, std::size_t edgesPerNode) {
+    using node_type = wilderfield::algorithms::csr_graph::node_type;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> span(1, 1024);
+    std::vector<std::pair<node_type, node_type>> edges;
+    edges.reserve(nodes * edgesPerNode);
+    for (std::size_t u = 0; u + 1 < nodes; ++u) {
+        for (std::size_t e = 0; e < edgesPerNode; ++e) {
+            edges.emplace_back(static_cast<node_type>(u), static_cast<node_type>(std::min(nodes - 1, u + span(gen))));
+        }
+    }
+    return wilderfield::algorithms::csr_graph(nodes, edges);
+}
+
+static void BM_TopologicalSort(benchmark::State& state) {
+    auto graph = makeRandomDag(state.range(0), 10);
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::topological_sort(graph);
+        benchmark::DoNotOptimize(result.order.data());
+    }
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_TopologicalSort)->RangeMultiplier(8)->Range(1<<14, 1<<20)->Unit(benchmark::kMillisecond);
+
+// Plain Kahn's algorithm with an indegree array and a FIFO queue, for reference
+static void BM_TopologicalSortQueue(benchmark::State& state) {
+    using node_type = wilderfield::algorithms::csr_graph::node_type;
+    auto graph = makeRandomDag(state.range(0), 10);
+    const std::size_t n = graph.node_count();
+
+    for (auto _ : state) {
+        // This code gets timed
+        std::vector<std::size_t> indegree(n, 0);
+        for (auto v : graph.targets()) {
+            indegree[v]++;
+        }
+        std::vector<node_type> order;
+        order.reserve(n);
+        for (node_type u = 0; u < n; ++u) {
+            if (indegree[u] == 0) {
+                order.push_back(u);
+            }
+        }
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (auto v : graph.neighbors(order[i])) {
+                if (--indegree[v] == 0) {
+                    order.push_back(v);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(order.data());
+    }
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_TopologicalSortQueue)->RangeMultiplier(8)->Range(1<<14, 1<<20)->Unit(benchmark::kMillisecond);
+
+// Stand-in for a build step, a couple of microseconds of arithmetic
+static std::uint64_t simulatedTask(std::uint64_t seed) {
+    for (int i = 0; i < 2000; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    }
+    return seed;
+}
+
+// Runs a task per node of a 64K-node DAG on state.range(0) workers
+static void BM_LevelScheduler(benchmark::State& state) {
+    auto graph = makeRandomDag(1 << 16, 10);
+    wilderfield::algorithms::level_scheduler scheduler(static_cast<std::size_t>(state.range(0)));
+    std::vector<std::uint64_t> outputs(graph.node_count());
+
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = scheduler.run(graph, [&](wilderfield::algorithms::csr_graph::node_type u) {
+            outputs[u] = simulatedTask(u);
+        });
+        benchmark::DoNotOptimize(result.order.data());
+    }
+    benchmark::DoNotOptimize(outputs.data());
+    state.SetItemsProcessed(state.iterations() * graph.node_count());
+}
+
+BENCHMARK(BM_LevelScheduler)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The same tasks run one after another in topological order, for reference
+static void BM_LevelSchedulerSerial(benchmark::State& state) {
+    auto graph = makeRandomDag(1 << 16, 10);
+    std::vector<std::uint64_t> outputs(graph.node_count());
+
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::topological_sort(graph);
+        for (auto u : result.order) {
+            outputs[u] = simulatedTask(u);
+        }
+        benchmark::DoNotOptimize(result.order.data());
+    }
+    benchmark::DoNotOptimize(outputs.data());
+    state.SetItemsProcessed(state.iterations() * graph.node_count());
+}
+
+BENCHMARK(BM_LevelSchedulerSerial)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// 32K tasks on state.range(0) workers. Each task does a couple of microseconds
+// of work and then bumps the priority of another task, which may still be waiting.
+static void BM_PriorityScheduler(benchmark::State& state) {
+    const int tasks = 1 << 15;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> priorities(0, 63);
+    std::uniform_int_distribution<int> ids(0, tasks - 1);
+    std::vector<int> initial(tasks);
+    std::vector<int> bumped(tasks);
+    for (int i = 0; i < tasks; ++i) {
+        initial[i] = priorities(gen);
+        bumped[i] = ids(gen);
+    }
+    std::vector<std::uint64_t> outputs(tasks);
+
+    for (auto _ : state) {
+        // This code gets timed
+        std::atomic<long> bumps(0);
+        wilderfield::priority_scheduler<int> scheduler(static_cast<std::size_t>(state.range(0)), [&](const int& task) {
+            outputs[task] = simulatedTask(task);
+            bumps += scheduler.increase(bumped[task]);
+        });
+        for (int i = 0; i < tasks; ++i) {
+            scheduler.submit(i, initial[i]);
+        }
+        scheduler.wait();
+        benchmark::DoNotOptimize(bumps.load());
+    }
+    benchmark::DoNotOptimize(outputs.data());
+    state.SetItemsProcessed(state.iterations() * tasks);
+}
+
+BENCHMARK(BM_PriorityScheduler)->RangeMultiplier(2)->Range(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// side x side grid with 4-neighbour edges of random weight in [1, 100]
+static wilderfield::algorithms::weighted_csr_graph<long> makeGridGraph(std::size_t side) {
+    using graph_type = wilderfield::algorithms::weighted_csr_graph<long>;
+    using node_type = graph_type::node_type;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<long> weight(1, 100);
+    std::vector<graph_type::edge_type> edges;
+    for (std::size_t r = 0; r < side; ++r) {
+        for (std::size_t c = 0; c < side; ++c) {
+            const auto u = static_cast<node_type>(r * side + c);
+            if (c + 1 < side) {
+                edges.emplace_back(u, u + 1, weight(gen));
+            }
+            if (r + 1 < side) {
+                edges.emplace_back(u, static_cast<node_type>(u + side), weight(gen));
+            }
+        }
+    }
+    return graph_type(side * side, edges, true);
+}
+
+// nodes nodes with 8 random out-edges each of random weight in [1, 1000]
+static wilderfield::algorithms::weighted_csr_graph<long> makeRandomWeightedGraph(std::size_t nodes) {
+    using graph_type = wilderfield::algorithms::weighted_csr_graph<long>;
+    using node_type = graph_type::node_type;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> target(0, nodes - 1);
+    std::uniform_int_distribution<long> weight(1, 1000);
+    std::vector<graph_type::edge_type> edges;
+    edges.reserve(nodes * 8);
+    for (std::size_t u = 0; u < nodes; ++u) {
+        for (int e = 0; e < 8; ++e) {
+            edges.emplace_back(static_cast<node_type>(u), static_cast<node_type>(target(gen)), weight(gen));
+        }
+    }
+    return graph_type(nodes, edges);
+}
+
+// Textbook Dijkstra that pushes a new entry per improvement and skips stale ones when popped
+static std::vector<long> dijkstraLazyHeap(const wilderfield::algorithms::weighted_csr_graph<long>& graph, unsigned source, std::size_t& pushes) {
+    std::vector<long> distance(graph.node_count(), std::numeric_limits<long>::max());
+    std::priority_queue<std::pair<long, unsigned>, std::vector<std::pair<long, unsigned>>, std::greater<>> heap;
+    distance[source] = 0;
+    heap.emplace(0, source);
+    pushes = 1;
+    while (!heap.empty()) {
+        auto [d, u] = heap.top();
+        heap.pop();
+        if (d != distance[u]) {
+            continue;
+        }
+        const auto targets = graph.neighbors(u);
+        const auto weights = graph.weights(u);
+        for (std::size_t e = 0; e < targets.size(); ++e) {
+            const unsigned v = targets.begin()[e];
+            if (d + weights.begin()[e] < distance[v]) {
+                distance[v] = d + weights.begin()[e];
+                heap.emplace(distance[v], v);
+                ++pushes;
+            }
+        }
+    }
+    return distance;
+}
+
+static void BM_DijkstraGrid(benchmark::State& state) {
+    auto graph = makeGridGraph(state.range(0));
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::dijkstra(graph, 0);
+        benchmark::DoNotOptimize(result.distance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_DijkstraGrid)->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMillisecond);
+
+static void BM_DijkstraGridLazyHeap(benchmark::State& state) {
+    auto graph = makeGridGraph(state.range(0));
+    std::size_t pushes = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        auto distance = dijkstraLazyHeap(graph, 0, pushes);
+        benchmark::DoNotOptimize(distance.data());
+    }
+    state.counters["stale_pushes"] = static_cast<double>(pushes - graph.node_count());
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_DijkstraGridLazyHeap)->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMillisecond);
+
+static void BM_DijkstraRandom(benchmark::State& state) {
+    auto graph = makeRandomWeightedGraph(state.range(0));
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::dijkstra(graph, 0);
+        benchmark::DoNotOptimize(result.distance.data());
+    }
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_DijkstraRandom)->RangeMultiplier(8)->Range(1<<12, 1<<18)->Unit(benchmark::kMillisecond);
+
+static void BM_DijkstraRandomLazyHeap(benchmark::State& state) {
+    auto graph = makeRandomWeightedGraph(state.range(0));
+    std::size_t pushes = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        auto distance = dijkstraLazyHeap(graph, 0, pushes);
+        benchmark::DoNotOptimize(distance.data());
+    }
+    state.counters["stale_pushes"] = static_cast<double>(pushes - graph.node_count());
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_DijkstraRandomLazyHeap)->RangeMultiplier(8)->Range(1<<12, 1<<18)->Unit(benchmark::kMillisecond);
+
+// Pattern of the 5-point (dims 2) or 7-point (dims 3) Laplacian on a grid with side points per axis,
+// the kind of matrix the SuiteSparse collection is full of
+static wilderfield::algorithms::csr_graph makeLaplacianPattern(std::size_t side, int dims) {
+    using node_type = wilderfield::algorithms::csr_graph::node_type;
+    const std::size_t planes = dims == 3 ? side : 1;
+    std::vector<std::pair<node_type, node_type>> edges;
+    for (std::size_t z = 0; z < planes; ++z) {
+        for (std::size_t y = 0; y < side; ++y) {
+            for (std::size_t x = 0; x < side; ++x) {
+                const auto u = static_cast<node_type>((z * side + y) * side + x);
+                if (x + 1 < side) {
+                    edges.emplace_back(u, u + 1);
+                }
+                if (y + 1 < side) {
+                    edges.emplace_back(u, static_cast<node_type>(u + side));
+                }
+                if (z + 1 < planes) {
+                    edges.emplace_back(u, static_cast<node_type>(u + side * side));
+                }
+            }
+        }
+    }
+    return wilderfield::algorithms::csr_graph(planes * side * side, edges, true);
+}
+
+static void BM_MinimumDegree2D(benchmark::State& state) {
+    auto graph = makeLaplacianPattern(state.range(0), 2);
+    std::size_t fill = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::minimum_degree_ordering(graph);
+        fill = result.fill;
+        benchmark::DoNotOptimize(result.order.data());
+    }
+    state.counters["fill"] = static_cast<double>(fill);
+    state.SetItemsProcessed(state.iterations() * graph.node_count());
+}
+
+BENCHMARK(BM_MinimumDegree2D)->RangeMultiplier(2)->Range(32, 256)->Unit(benchmark::kMillisecond);
+
+static void BM_MinimumDegree3D(benchmark::State& state) {
+    auto graph = makeLaplacianPattern(state.range(0), 3);
+    std::size_t fill = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::minimum_degree_ordering(graph);
+        fill = result.fill;
+        benchmark::DoNotOptimize(result.order.data());
+    }
+    state.counters["fill"] = static_cast<double>(fill);
+    state.SetItemsProcessed(state.iterations() * graph.node_count());
+}
+
+BENCHMARK(BM_MinimumDegree3D)->RangeMultiplier(2)->Range(8, 16)->Unit(benchmark::kMillisecond);
+
+// The same elimination with degrees kept in a std::set of (degree, node), for reference
+static void BM_MinimumDegree2DSet(benchmark::State& state) {
+    using node_type = wilderfield::algorithms::csr_graph::node_type;
+    auto graph = makeLaplacianPattern(state.range(0), 2);
+    const std::size_t n = graph.node_count();
+
+    for (auto _ : state) {
+        // This code gets timed
+        std::vector<std::vector<node_type>> adjacency(n);
+        std::set<std::pair<long, node_type>> byDegree;
+        for (std::size_t u = 0; u < n; ++u) {
+            auto neighbors = graph.neighbors(static_cast<node_type>(u));
+            adjacency[u].assign(neighbors.begin(), neighbors.end());
+            std::sort(adjacency[u].begin(), adjacency[u].end());
+            byDegree.emplace(static_cast<long>(adjacency[u].size()), static_cast<node_type>(u));
+        }
+
+        std::vector<node_type> order;
+        std::vector<node_type> merged;
+        while (!byDegree.empty()) {
+            const node_type v = byDegree.begin()->second;
+            byDegree.erase(byDegree.begin());
+            order.push_back(v);
+            const auto& clique = adjacency[v];
+            for (auto u : clique) {
+                auto& row = adjacency[u];
+                merged.clear();
+                std::set_union(row.begin(), row.end(), clique.begin(), clique.end(), std::back_inserter(merged));
+                merged.erase(std::remove_if(merged.begin(), merged.end(), [&](node_type w) { return w == u || w == v; }), merged.end());
+                if (merged.size() != row.size()) {
+                    byDegree.erase({static_cast<long>(row.size()), u});
+                    byDegree.emplace(static_cast<long>(merged.size()), u);
+                }
+                row.swap(merged);
+            }
+            std::vector<node_type>().swap(adjacency[v]);
+        }
+        benchmark::DoNotOptimize(order.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_MinimumDegree2DSet)->RangeMultiplier(2)->Range(32, 256)->Unit(benchmark::kMillisecond);
+
+static void BM_Dsatur(benchmark::State& state) {
+    auto graph = makeRandomGraph(state.range(0), 8);
+    std::size_t colors = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::dsatur_coloring(graph);
+        colors = result.color_count;
+        benchmark::DoNotOptimize(result.color.data());
+    }
+    state.counters["colors"] = static_cast<double>(colors);
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_Dsatur)->RangeMultiplier(8)->Range(1<<12, 1<<18)->Unit(benchmark::kMillisecond);
+
+// DSatur with the same composite priority in a std::set of (priority, node), for reference
+static void BM_DsaturSet(benchmark::State& state) {
+    using node_type = wilderfield::algorithms::csr_graph::node_type;
+    auto graph = makeRandomGraph(state.range(0), 8);
+    const std::size_t n = graph.node_count();
+    std::size_t maxDegree = 0;
+    for (std::size_t u = 0; u < n; ++u) {
+        maxDegree = std::max(maxDegree, graph.degree(static_cast<node_type>(u)));
+    }
+    const long saturationStep = static_cast<long>(maxDegree) + 1;
+    std::size_t colors = 0;
+
+    for (auto _ : state) {
+        // This code gets timed
+        std::vector<long> priority(n);
+        std::set<std::pair<long, node_type>, std::greater<>> candidates;
+        for (std::size_t u = 0; u < n; ++u) {
+            priority[u] = static_cast<long>(graph.degree(static_cast<node_type>(u)));
+            candidates.emplace(priority[u], static_cast<node_type>(u));
+        }
+        std::vector<std::uint32_t> color(n, ~std::uint32_t(0));
+        std::vector<std::vector<bool>> neighborColors(n);
+        colors = 0;
+
+        while (!candidates.empty()) {
+            const node_type v = candidates.begin()->second;
+            candidates.erase(candidates.begin());
+            const auto& used = neighborColors[v];
+            std::uint32_t c = 0;
+            while (c < used.size() && used[c]) {
+                ++c;
+            }
+            color[v] = c;
+            colors = std::max<std::size_t>(colors, c + 1);
+
+            for (auto u : graph.neighbors(v)) {
+                if (color[u] != ~std::uint32_t(0)) {
+                    continue;
+                }
+                auto& seen = neighborColors[u];
+                if (seen.size() <= c) {
+                    seen.resize(c + 1, false);
+                }
+                candidates.erase({priority[u], u});
+                if (seen[c]) {
+                    --priority[u];
+                }
+                else {
+                    seen[c] = true;
+                    priority[u] += saturationStep - 1;
+                }
+                candidates.emplace(priority[u], u);
+            }
+        }
+        benchmark::DoNotOptimize(color.data());
+    }
+    state.counters["colors"] = static_cast<double>(colors);
+    state.SetItemsProcessed(state.iterations() * graph.edge_count());
+}
+
+BENCHMARK(BM_DsaturSet)->RangeMultiplier(8)->Range(1<<12, 1<<18)->Unit(benchmark::kMillisecond);
+
+// sets sets of 1 to 128 elements out of 1M, skewed towards low element ids
+static std::vector<std::vector<std::uint32_t>> makeSetCoverInstance(std::size_t sets, std::uint32_t elements) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> size(1, 128);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<std::vector<std::uint32_t>> instance(sets);
+    for (auto& set : instance) {
+        const int count = size(gen);
+        for (int i = 0; i < count; ++i) {
+            set.push_back(static_cast<std::uint32_t>(elements * dist(gen) * dist(gen)));
+        }
+    }
+    return instance;
+}
+
+static void BM_GreedySetCover(benchmark::State& state) {
+    const std::uint32_t elements = 1 << 20;
+    auto sets = makeSetCoverInstance(state.range(0), elements);
+    std::size_t chosen = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::greedy_set_cover(sets, elements);
+        chosen = result.chosen.size();
+        benchmark::DoNotOptimize(result.chosen.data());
+    }
+    state.counters["chosen"] = static_cast<double>(chosen);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_GreedySetCover)->RangeMultiplier(4)->Range(1<<14, 1<<18)->Unit(benchmark::kMillisecond);
+
+// The same lazy greedy with a std::priority_queue, which re-pushes a stale top
+// instead of moving it, for reference. Sets are deduplicated untimed.
+static void BM_GreedySetCoverLazyHeap(benchmark::State& state) {
+    const std::uint32_t elements = 1 << 20;
+    auto sets = makeSetCoverInstance(state.range(0), elements);
+    for (auto& set : sets) {
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+    }
+    std::size_t chosen = 0;
+
+    for (auto _ : state) {
+        // This code gets timed
+        std::vector<std::size_t> offsets(elements + 1, 0);
+        for (const auto& set : sets) {
+            for (auto e : set) {
+                offsets[e + 1]++;
+            }
+        }
+        for (std::uint32_t e = 0; e < elements; ++e) {
+            offsets[e + 1] += offsets[e];
+        }
+        std::vector<std::uint32_t> containing(offsets.back());
+        std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::uint32_t s = 0; s < sets.size(); ++s) {
+            for (auto e : sets[s]) {
+                containing[next[e]++] = s;
+            }
+        }
+
+        std::vector<long> gain(sets.size());
+        std::priority_queue<std::pair<long, std::uint32_t>> heap;
+        for (std::uint32_t s = 0; s < sets.size(); ++s) {
+            gain[s] = static_cast<long>(sets[s].size());
+            heap.emplace(gain[s], s);
+        }
+        std::vector<bool> covered(elements, false);
+        std::vector<bool> picked(sets.size(), false);
+        chosen = 0;
+
+        while (!heap.empty()) {
+            auto [g, s] = heap.top();
+            heap.pop();
+            if (picked[s] || gain[s] == 0) {
+                continue;
+            }
+            if (g != gain[s]) {
+                heap.emplace(gain[s], s);
+                continue;
+            }
+            picked[s] = true;
+            ++chosen;
+            for (auto e : sets[s]) {
+                if (!covered[e]) {
+                    covered[e] = true;
+                    for (std::size_t i = offsets[e]; i < offsets[e + 1]; ++i) {
+                        --gain[containing[i]];
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(gain.data());
+    }
+    state.counters["chosen"] = static_cast<double>(chosen);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_GreedySetCoverLazyHeap)->RangeMultiplier(4)->Range(1<<14, 1<<18)->Unit(benchmark::kMillisecond);
+
+// bytes of text-like data: a geometric spread over the 256 byte values
+static std::string makeSkewedBytes(std::size_t bytes) {
+    std::mt19937 gen(42);
+    std::geometric_distribution<int> dist(0.05);
+    std::string data(bytes, '\0');
+    for (auto& c : data) {
+        c = static_cast<char>(dist(gen) % 256);
+    }
+    return data;
+}
+
+static void BM_HuffmanCodeLengths(benchmark::State& state) {
+    const auto data = makeSkewedBytes(state.range(0));
+    for (auto _ : state) {
+        // This code gets timed
+        auto result = wilderfield::algorithms::huffman_code_lengths(data.begin(), data.end());
+        benchmark::DoNotOptimize(result.lengths.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_HuffmanCodeLengths)->RangeMultiplier(8)->Range(1<<16, 1<<24)->Unit(benchmark::kMillisecond);
+
+// Counting into a byte histogram and building the tree with a heap, for reference
+static void BM_HuffmanCodeLengthsHistogram(benchmark::State& state) {
+    const auto data = makeSkewedBytes(state.range(0));
+    for (auto _ : state) {
+        // This code gets timed
+        std::vector<std::size_t> histogram(256, 0);
+        for (auto c : data) {
+            histogram[static_cast<unsigned char>(c)]++;
+        }
+        using Node = std::pair<std::size_t, int>;
+        std::priority_queue<Node, std::vector<Node>, std::greater<Node>> heap;
+        std::vector<int> parent;
+        for (int c = 0; c < 256; ++c) {
+            if (histogram[c] > 0) {
+                heap.emplace(histogram[c], static_cast<int>(parent.size()));
+                parent.push_back(-1);
+            }
+        }
+        const std::size_t leaves = parent.size();
+        while (heap.size() > 1) {
+            auto [wa, a] = heap.top();
+            heap.pop();
+            auto [wb, b] = heap.top();
+            heap.pop();
+            parent[a] = parent[b] = static_cast<int>(parent.size());
+            heap.emplace(wa + wb, static_cast<int>(parent.size()));
+            parent.push_back(-1);
+        }
+        std::vector<std::size_t> lengths(leaves, 0);
+        for (std::size_t leaf = 0; leaf < leaves; ++leaf) {
+            for (int node = parent[leaf]; node >= 0; node = parent[node]) {
+                lengths[leaf]++;
+            }
+        }
+        benchmark::DoNotOptimize(lengths.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_HuffmanCodeLengthsHistogram)->RangeMultiplier(8)->Range(1<<16, 1<<24)->Unit(benchmark::kMillisecond);
 
 BENCHMARK_MAIN();
 
@@ -0,0 +1,127 @@
+/**
+ * @file csr_graph.hpp
+ * @brief Compressed Sparse Row Graph Class Definition
+ *
+ * Defines the graph representation taken by the algorithms in
+ * wilderfield::algorithms: the targets of every edge in one array, grouped by
+ * source node, and the offset of each node's group in a second array.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_CSR_GRAPH_HPP
+#define WILDERFIELD_ALGORITHMS_CSR_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Compressed sparse row graph class
+ *
+ * Nodes are numbered 0 .. node_count() - 1. The out-neighbors of node u are
+ * targets()[offsets()[u] .. offsets()[u + 1]). An undirected graph stores each
+ * edge in both directions.
+ */
+class csr_graph final {
+
+public:
+    using node_type = std::uint32_t; ///< Type of the node ids.
+
+    /**
+     * @brief Contiguous range of neighbor ids, usable in range-based for loops.
+     */
+    struct neighbor_range {
+        const node_type* first;
+        const node_type* last;
+
+        const node_type* begin() const { return first; }
+        const node_type* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    };
+
+private:
+    std::vector<std::size_t> offsets_; ///< Start of each node's targets, plus the edge count at the end.
+    std::vector<node_type> targets_;   ///< Edge targets grouped by source node.
+
+public:
+
+    csr_graph() : offsets_(1, 0) {}
+
+    csr_graph(std::vector<std::size_t> offsets, std::vector<node_type> targets); ///< Adopts prepared CSR arrays. Throws std::invalid_argument if they are inconsistent.
+
+    csr_graph(std::size_t nodes, const std::vector<std::pair<node_type, node_type>>& edges, bool undirected = false); ///< Builds from an edge list, adding the reverse of each edge when undirected. Edges of a node keep their input order.
+
+    std::size_t node_count() const { return offsets_.size() - 1; } ///< Returns the number of nodes.
+
+    std::size_t edge_count() const { return targets_.size(); } ///< Returns the number of stored (directed) edges.
+
+    std::size_t degree(node_type u) const { return offsets_[u + 1] - offsets_[u]; } ///< Returns the out-degree of u.
+
+    neighbor_range neighbors(node_type u) const { return {targets_.data() + offsets_[u], targets_.data() + offsets_[u + 1]}; } ///< Returns the out-neighbors of u.
+
+    const std::vector<std::size_t>& offsets() const { return offsets_; } ///< Returns the offset array.
+
+    const std::vector<node_type>& targets() const { return targets_; } ///< Returns the target array.
+};
+
+// Out-of-line implementation of csr_graph methods
+
+inline csr_graph::csr_graph(std::vector<std::size_t> offsets, std::vector<node_type> targets)
+    : offsets_(std::move(offsets)), targets_(std::move(targets)) {
+    if (offsets_.empty() || offsets_.front() != 0 || offsets_.back() != targets_.size()) {
+        throw std::invalid_argument("Offsets don't span the targets of csr_graph.");
+    }
+    if (offsets_.size() - 1 > std::numeric_limits<node_type>::max()) {
+        throw std::invalid_argument("Too many nodes for csr_graph.");
+    }
+    for (std::size_t u = 1; u < offsets_.size(); u++) {
+        if (offsets_[u] < offsets_[u - 1]) {
+            throw std::invalid_argument("Decreasing offsets in csr_graph.");
+        }
+    }
+    for (auto v : targets_) {
+        if (v >= offsets_.size() - 1) {
+            throw std::invalid_argument("Edge target out of range in csr_graph.");
+        }
+    }
+}
+
+inline csr_graph::csr_graph(std::size_t nodes, const std::vector<std::pair<node_type, node_type>>& edges, bool undirected)
+    : offsets_(nodes + 1, 0) {
+    if (nodes > std::numeric_limits<node_type>::max()) {
+        throw std::invalid_argument("Too many nodes for csr_graph.");
+    }
+
+    // Counting sort of the edges by source
+    for (const auto& edge : edges) {
+        if (edge.first >= nodes || edge.second >= nodes) {
+            throw std::invalid_argument("Edge endpoint out of range in csr_graph.");
+        }
+        offsets_[edge.first + 1]++;
+        if (undirected) {
+            offsets_[edge.second + 1]++;
+        }
+    }
+    for (std::size_t u = 0; u < nodes; u++) {
+        offsets_[u + 1] += offsets_[u];
+    }
+
+    targets_.resize(offsets_.back());
+    std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (const auto& edge : edges) {
+        targets_[next[edge.first]++] = edge.second;
+        if (undirected) {
+            targets_[next[edge.second]++] = edge.first;
+        }
+    }
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_CSR_GRAPH_HPP
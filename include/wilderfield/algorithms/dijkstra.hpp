@@ -0,0 +1,98 @@
+/**
+ * @file dijkstra.hpp
+ * @brief Single-Source Shortest Paths Definition
+ *
+ * Defines dijkstra, which settles nodes in order of distance from a source,
+ * keeping the frontier in a min priority_map so that a shorter path to a
+ * frontier node lowers its entry in place.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_DIJKSTRA_HPP
+#define WILDERFIELD_ALGORITHMS_DIJKSTRA_HPP
+
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/algorithms/weighted_csr_graph.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Result of dijkstra.
+ */
+template<typename Weight>
+struct dijkstra_result {
+    static constexpr csr_graph::node_type no_parent = std::numeric_limits<csr_graph::node_type>::max(); ///< Parent of the source and of unreachable nodes.
+
+    std::vector<Weight> distance;              ///< Distance of each node from the source, std::numeric_limits<Weight>::max() if unreachable.
+    std::vector<csr_graph::node_type> parent;  ///< Previous node on a shortest path to each node.
+
+    bool reachable(csr_graph::node_type u) const { return distance[u] != std::numeric_limits<Weight>::max(); } ///< Checks whether u is reachable from the source.
+};
+
+/**
+ * @brief Computes shortest path distances and a shortest path tree from source.
+ *
+ * Every node is in the frontier at most once. Finding a shorter path to a
+ * frontier node assigns its new distance, a decrease-key, instead of pushing a
+ * second entry, so the frontier never holds stale entries. Distances are
+ * mostly distinct, so these assignments usually move a node far along the
+ * map's value list, which the map serves from its ordered value index.
+ *
+ * Throws std::invalid_argument on a negative edge weight or a source out of range.
+ */
+template<typename Weight>
+dijkstra_result<Weight> dijkstra(const weighted_csr_graph<Weight>& graph, csr_graph::node_type source) {
+    using node_type = csr_graph::node_type;
+    const std::size_t n = graph.node_count();
+    if (source >= n) {
+        throw std::invalid_argument("Source out of range in dijkstra.");
+    }
+    if constexpr (std::is_signed<Weight>::value) {
+        for (const auto& weight : graph.weights()) {
+            if (weight < 0) {
+                throw std::invalid_argument("Negative edge weight in dijkstra.");
+            }
+        }
+    }
+
+    dijkstra_result<Weight> result;
+    result.distance.assign(n, std::numeric_limits<Weight>::max());
+    result.parent.assign(n, dijkstra_result<Weight>::no_parent);
+    std::vector<bool> settled(n, false);
+
+    priority_map<node_type, Weight, std::less<Weight>> frontier;
+    result.distance[source] = 0;
+    frontier.assign(source, 0);
+
+    while (!frontier.empty()) {
+        const auto [u, distance] = frontier.top();
+        frontier.pop();
+        settled[u] = true;
+
+        const auto targets = graph.neighbors(u);
+        const auto weights = graph.weights(u);
+        for (std::size_t e = 0; e < targets.size(); e++) {
+            const node_type v = targets.begin()[e];
+            const Weight candidate = distance + weights.begin()[e];
+            if (!settled[v] && candidate < result.distance[v]) {
+                result.distance[v] = candidate;
+                result.parent[v] = u;
+                frontier.assign(v, candidate);
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_DIJKSTRA_HPP
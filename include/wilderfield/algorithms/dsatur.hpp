@@ -0,0 +1,103 @@
+/**
+ * @file dsatur.hpp
+ * @brief DSatur Graph Coloring Definition
+ *
+ * Defines dsatur_coloring, Brélaz's greedy coloring that always colors next the
+ * node whose neighbors already use the most distinct colors.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_DSATUR_HPP
+#define WILDERFIELD_ALGORITHMS_DSATUR_HPP
+
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Result of dsatur_coloring.
+ */
+struct dsatur_result {
+    std::vector<std::uint32_t> color; ///< Color of each node, numbered from 0.
+    std::size_t color_count = 0;      ///< Number of colors used.
+};
+
+/**
+ * @brief Colors an undirected graph with the DSatur heuristic.
+ *
+ * Picks the uncolored node of highest saturation, the number of distinct
+ * colors among its neighbors, breaking ties by the most uncolored neighbors,
+ * and gives it the smallest color its neighbors don't use. Both criteria are
+ * folded into one priority, saturation * (maxDegree + 1) + uncolored degree,
+ * in a max priority_map. Coloring a node lowers each uncolored neighbor's
+ * priority by one, or raises it by maxDegree when the color is new to that
+ * neighbor.
+ *
+ * @param graph An undirected graph, storing every edge in both directions. Self loops are ignored.
+ */
+inline dsatur_result dsatur_coloring(const csr_graph& graph) {
+    using node_type = csr_graph::node_type;
+    const std::size_t n = graph.node_count();
+    constexpr std::uint32_t uncolored = ~std::uint32_t(0);
+
+    std::size_t maxDegree = 0;
+    for (std::size_t u = 0; u < n; u++) {
+        maxDegree = std::max(maxDegree, graph.degree(static_cast<node_type>(u)));
+    }
+    const long saturationStep = static_cast<long>(maxDegree) + 1;
+
+    std::vector<std::pair<node_type, long>> priorities(n);
+    for (std::size_t u = 0; u < n; u++) {
+        priorities[u] = {static_cast<node_type>(u), static_cast<long>(graph.degree(static_cast<node_type>(u)))};
+    }
+    priority_map<node_type, long> candidates(priorities.begin(), priorities.end());
+
+    dsatur_result result;
+    result.color.assign(n, uncolored);
+    std::vector<std::vector<bool>> neighborColors(n); // Grown on demand, most nodes see few colors
+
+    while (!candidates.empty()) {
+        const node_type v = candidates.top().first;
+        candidates.pop();
+
+        // Smallest color not used around v
+        const auto& used = neighborColors[v];
+        std::uint32_t c = 0;
+        while (c < used.size() && used[c]) {
+            c++;
+        }
+        result.color[v] = c;
+        result.color_count = std::max<std::size_t>(result.color_count, c + 1);
+        std::vector<bool>().swap(neighborColors[v]);
+
+        for (auto u : graph.neighbors(v)) {
+            if (result.color[u] != uncolored) {
+                continue;
+            }
+            auto& seen = neighborColors[u];
+            if (seen.size() <= c) {
+                seen.resize(c + 1, false);
+            }
+            if (seen[c]) {
+                --candidates[u];
+            }
+            else {
+                seen[c] = true;
+                candidates[u] += saturationStep - 1;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_DSATUR_HPP
@@ -0,0 +1,137 @@
+/**
+ * @file huffman.hpp
+ * @brief Huffman Code Length Definition
+ *
+ * Defines huffman_code_lengths, which counts the symbols of a stream and
+ * computes the code lengths of an optimal prefix code for them, ready for
+ * canonical code assignment.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_HUFFMAN_HPP
+#define WILDERFIELD_ALGORITHMS_HUFFMAN_HPP
+
+#include "wilderfield/priority_map.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Result of huffman_code_lengths.
+ *
+ * The three vectors are aligned and list the distinct symbols from the most
+ * frequent to the least, so lengths never decrease. Giving each symbol in
+ * turn the next code of its length, starting from all zeros, yields the
+ * canonical code for this order.
+ */
+template<typename Symbol>
+struct huffman_result {
+    std::vector<Symbol> symbols;      ///< Distinct symbols, most frequent first. Symbols of equal count are in no particular order.
+    std::vector<std::size_t> counts;  ///< Occurrences of each symbol.
+    std::vector<std::size_t> lengths; ///< Code length of each symbol in bits.
+};
+
+/**
+ * @brief Counts the symbols in [first, last) and computes Huffman code lengths.
+ *
+ * Symbols are first counted in a flat table when they are single bytes and a
+ * hash table otherwise, since the ordering only matters once counting ends.
+ * The counts are then bulk loaded into a min priority_map, and draining it
+ * bucket by bucket yields the symbols in increasing count order, which is
+ * exactly the order the two-queue Huffman construction consumes: leaves are
+ * taken from the drained order and merged nodes from a second queue whose
+ * weights never decrease, so the tree is built in linear time.
+ *
+ * A stream of a single distinct symbol gives it a length of 1.
+ */
+template<typename InputIt, typename Hash = std::hash<typename std::iterator_traits<InputIt>::value_type>>
+huffman_result<typename std::iterator_traits<InputIt>::value_type> huffman_code_lengths(InputIt first, InputIt last) {
+    using Symbol = typename std::iterator_traits<InputIt>::value_type;
+
+    std::vector<std::pair<Symbol, std::size_t>> tallies;
+    if constexpr (std::is_integral<Symbol>::value && sizeof(Symbol) == 1) {
+        std::array<std::size_t, 256> table{};
+        for (; first != last; ++first) {
+            table[static_cast<unsigned char>(*first)]++;
+        }
+        for (std::size_t byte = 0; byte < table.size(); byte++) {
+            if (table[byte] > 0) {
+                tallies.emplace_back(static_cast<Symbol>(static_cast<unsigned char>(byte)), table[byte]);
+            }
+        }
+    }
+    else {
+        std::unordered_map<Symbol, std::size_t, Hash> table;
+        for (; first != last; ++first) {
+            table[*first]++;
+        }
+        tallies.assign(table.begin(), table.end());
+    }
+    priority_map<Symbol, std::size_t, std::less<std::size_t>, Hash> counts(tallies.begin(), tallies.end(), 1);
+
+    // Leaves in increasing count order, straight from the buckets
+    huffman_result<Symbol> result;
+    const std::size_t n = counts.size();
+    result.symbols.reserve(n);
+    result.counts.reserve(n);
+    while (!counts.empty()) {
+        const std::size_t count = counts.top().second;
+        counts.pop_top_bucket(std::back_inserter(result.symbols));
+        result.counts.resize(result.symbols.size(), count);
+    }
+    if (n == 0) {
+        return result;
+    }
+
+    // Nodes 0 .. n - 1 are leaves, n .. 2n - 2 merged nodes in creation order
+    std::vector<std::size_t> weight(result.counts);
+    std::vector<std::size_t> parent(2 * n - 1, 0);
+    weight.resize(2 * n - 1);
+    std::size_t nextLeaf = 0;
+    std::size_t nextMerged = n;
+    auto takeLightest = [&](std::size_t end) {
+        if (nextLeaf < n && (nextMerged == end || weight[nextLeaf] <= weight[nextMerged])) {
+            return nextLeaf++;
+        }
+        return nextMerged++;
+    };
+    for (std::size_t node = n; node < 2 * n - 1; node++) {
+        const std::size_t a = takeLightest(node);
+        const std::size_t b = takeLightest(node);
+        weight[node] = weight[a] + weight[b];
+        parent[a] = node;
+        parent[b] = node;
+    }
+
+    // Depths from the root down, which is every parent before its children
+    std::vector<std::size_t> depth(2 * n - 1, 0);
+    for (std::size_t node = 2 * n - 1; node-- > 0;) {
+        if (node != 2 * n - 2) {
+            depth[node] = depth[parent[node]] + 1;
+        }
+    }
+
+    // Most frequent first, so lengths come out nondecreasing
+    result.lengths.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+        result.lengths[i] = n == 1 ? 1 : depth[i];
+    }
+    std::reverse(result.symbols.begin(), result.symbols.end());
+    std::reverse(result.counts.begin(), result.counts.end());
+    std::reverse(result.lengths.begin(), result.lengths.end());
+    return result;
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_HUFFMAN_HPP
@@ -0,0 +1,169 @@
+/**
+ * @file level_scheduler.hpp
+ * @brief Parallel Level Scheduler Class Definition
+ *
+ * Defines level_scheduler, which runs a task per node of a dependency DAG on a
+ * work_stealing_pool, one topological level at a time.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_LEVEL_SCHEDULER_HPP
+#define WILDERFIELD_ALGORITHMS_LEVEL_SCHEDULER_HPP
+
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/algorithms/topological_sort.hpp"
+#include "wilderfield/priority_map.hpp"
+#include "wilderfield/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Parallel level scheduler class
+ *
+ * Runs a task for every node of a graph whose edges point from a node to the
+ * nodes depending on it. The ready nodes of a level are taken from a min
+ * priority_map of indegrees as a whole zero bucket and dealt to the pool in
+ * chunks, a few per worker, so stealing evens out tasks of uneven cost. The
+ * next level starts once every task of the current one has finished.
+ *
+ * Only the thread calling run() touches the map and the indegrees. Workers
+ * report each finished chunk, and the caller applies that chunk's indegree
+ * decrements as one batch while the other chunks are still running.
+ */
+class level_scheduler final {
+
+private:
+    static constexpr std::size_t chunksPerThread_ = 4; ///< Chunks a level is split into per worker.
+
+    work_stealing_pool pool_;
+
+public:
+
+    explicit level_scheduler(std::size_t threads = 0) : pool_(threads) {} ///< Starts threads workers, one per hardware thread when threads is 0.
+
+    std::size_t thread_count() const { return pool_.thread_count(); } ///< Returns the number of workers.
+
+    /**
+     * @brief Runs task(node) for every node, after the tasks of all its predecessors.
+     *
+     * Tasks of the same level may run concurrently. Returns the nodes in the
+     * order their levels ran, as topological_sort does. If a task throws, the
+     * rest of its level still runs, no later level is started, and the first
+     * exception is rethrown.
+     */
+    template<typename Task>
+    topological_sort_result run(const csr_graph& graph, Task&& task);
+};
+
+// Out-of-line implementation of level_scheduler methods
+
+template<typename Task>
+topological_sort_result level_scheduler::run(const csr_graph& graph, Task&& task) {
+    using node_type = csr_graph::node_type;
+    const std::size_t n = graph.node_count();
+
+    std::vector<long> indegree(n, 0);
+    for (auto v : graph.targets()) {
+        indegree[v]++;
+    }
+    std::vector<std::pair<node_type, long>> items(n);
+    for (std::size_t u = 0; u < n; u++) {
+        items[u] = {static_cast<node_type>(u), indegree[u]};
+    }
+    priority_map<node_type, long, std::less<long>> remaining(items.begin(), items.end());
+
+    topological_sort_result result;
+    result.order.reserve(n); // Workers read order while it must not reallocate
+    result.level_offsets.push_back(0);
+
+    std::mutex doneMutex;                              // Guards done and error.
+    std::condition_variable doneSignal;
+    std::vector<std::pair<std::size_t, std::size_t>> done; // Finished chunks not yet applied.
+    std::exception_ptr error;
+
+    std::vector<std::pair<std::size_t, std::size_t>> batch;
+    std::vector<node_type> ready;
+
+    while (!remaining.empty()) {
+        if (remaining.top().second != 0) {
+            result.acyclic = false;
+            break;
+        }
+
+        const std::size_t begin = result.order.size();
+        remaining.pop_top_bucket(std::back_inserter(result.order));
+        const std::size_t end = result.order.size();
+
+        const std::size_t chunk = std::max<std::size_t>(1, (end - begin) / (pool_.thread_count() * chunksPerThread_));
+        std::size_t chunks = 0;
+        for (std::size_t first = begin; first < end; first += chunk, chunks++) {
+            const std::size_t last = std::min(end, first + chunk);
+            pool_.submit([&, first, last] {
+                std::exception_ptr failure;
+                try {
+                    for (std::size_t i = first; i < last; i++) {
+                        task(result.order[i]);
+                    }
+                }
+                catch (...) {
+                    failure = std::current_exception();
+                }
+
+                // Notify under the lock, as run() may return as soon as it sees the last chunk
+                std::lock_guard<std::mutex> lock(doneMutex);
+                done.emplace_back(first, last);
+                if (failure && !error) {
+                    error = failure;
+                }
+                doneSignal.notify_one();
+            });
+        }
+
+        // Apply the decrements of finished chunks while the others run
+        for (std::size_t applied = 0; applied < chunks; ) {
+            {
+                std::unique_lock<std::mutex> lock(doneMutex);
+                doneSignal.wait(lock, [&] { return !done.empty(); });
+                batch.swap(done);
+            }
+            for (const auto& [first, last] : batch) {
+                for (std::size_t i = first; i < last; i++) {
+                    for (auto v : graph.neighbors(result.order[i])) {
+                        if (--indegree[v] == 0) {
+                            ready.push_back(v);
+                        }
+                    }
+                }
+            }
+            applied += batch.size();
+            batch.clear();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        // As in topological_sort, only ready nodes move, and only once the level is over
+        for (auto v : ready) {
+            remaining[v] = 0;
+        }
+        ready.clear();
+        result.level_offsets.push_back(end);
+    }
+    return result;
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_LEVEL_SCHEDULER_HPP
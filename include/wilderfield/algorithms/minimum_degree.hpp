@@ -0,0 +1,100 @@
+/**
+ * @file minimum_degree.hpp
+ * @brief Minimum Degree Ordering Definition
+ *
+ * Defines minimum_degree_ordering, a fill-reducing elimination order for
+ * sparse symmetric matrices, as used before a Cholesky factorization.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_MINIMUM_DEGREE_HPP
+#define WILDERFIELD_ALGORITHMS_MINIMUM_DEGREE_HPP
+
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Result of minimum_degree_ordering.
+ */
+struct minimum_degree_result {
+    std::vector<csr_graph::node_type> order; ///< Elimination order: row and column order[i] of the matrix goes to position i.
+    std::size_t fill = 0;                    ///< Off-diagonal entries, counted once per pair, that eliminating in this order fills in.
+};
+
+/**
+ * @brief Orders the nodes of a symmetric sparsity pattern by minimum degree.
+ *
+ * Repeatedly eliminates a node of minimum degree in the elimination graph,
+ * turning its remaining neighbors into a clique. The degrees of those
+ * neighbors change by small amounts, applied with += on a min priority_map,
+ * which moves each node a few buckets at most. This is the exact minimum
+ * degree algorithm on an explicit elimination graph, without the quotient
+ * graph, supervariables or approximate degrees of AMD, so it suits matrices
+ * whose factor stays moderately sparse.
+ *
+ * @param graph The pattern of the matrix, storing every off-diagonal entry in
+ * both directions. Self loops and repeated edges are ignored.
+ */
+inline minimum_degree_result minimum_degree_ordering(const csr_graph& graph) {
+    using node_type = csr_graph::node_type;
+    const std::size_t n = graph.node_count();
+
+    // Elimination graph, holding only nodes not yet eliminated
+    std::vector<std::vector<node_type>> adjacency(n);
+    std::vector<std::pair<node_type, long>> degrees(n);
+    for (std::size_t u = 0; u < n; u++) {
+        auto& row = adjacency[u];
+        for (auto v : graph.neighbors(static_cast<node_type>(u))) {
+            if (v != u) {
+                row.push_back(v);
+            }
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+        degrees[u] = {static_cast<node_type>(u), static_cast<long>(row.size())};
+    }
+    priority_map<node_type, long, std::less<long>> remaining(degrees.begin(), degrees.end());
+
+    minimum_degree_result result;
+    result.order.reserve(n);
+    std::vector<node_type> merged;
+
+    while (!remaining.empty()) {
+        const node_type v = remaining.top().first;
+        remaining.pop();
+        result.order.push_back(v);
+
+        // Each neighbor u gains the rest of the clique and loses v
+        const auto& clique = adjacency[v];
+        for (auto u : clique) {
+            auto& row = adjacency[u];
+            merged.clear();
+            std::set_union(row.begin(), row.end(), clique.begin(), clique.end(), std::back_inserter(merged));
+            merged.erase(std::remove_if(merged.begin(), merged.end(), [&](node_type w) { return w == u || w == v; }), merged.end());
+
+            const long delta = static_cast<long>(merged.size()) - static_cast<long>(row.size());
+            result.fill += static_cast<std::size_t>(delta + 1); // Both ends count each fill entry
+            row.swap(merged);
+            if (delta != 0) {
+                remaining[u] += delta;
+            }
+        }
+        std::vector<node_type>().swap(adjacency[v]);
+    }
+    result.fill /= 2;
+    return result;
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_MINIMUM_DEGREE_HPP
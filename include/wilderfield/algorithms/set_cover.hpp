@@ -0,0 +1,136 @@
+/**
+ * @file set_cover.hpp
+ * @brief Greedy Set Cover Definition
+ *
+ * Defines greedy_set_cover, the classic ln(n)-approximate set cover that
+ * repeatedly picks the set covering the most uncovered elements, and with a
+ * budget the (1 - 1/e)-approximate maximum coverage.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_SET_COVER_HPP
+#define WILDERFIELD_ALGORITHMS_SET_COVER_HPP
+
+#include "wilderfield/priority_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Result of greedy_set_cover.
+ */
+struct set_cover_result {
+    std::vector<std::uint32_t> chosen; ///< Indices of the chosen sets, in the order they were picked.
+    std::vector<std::size_t> gains;    ///< Elements newly covered by each chosen set.
+    std::size_t covered = 0;           ///< Elements covered by the chosen sets.
+};
+
+/**
+ * @brief Picks sets greedily by the number of elements they would newly cover.
+ *
+ * Exact gains are kept in an array: after each pick, every newly covered
+ * element costs each set containing it one unit of gain there. The sets sit in
+ * a max priority_map under upper bounds of their gains, and only a set that
+ * reaches the top with a stale bound moves, to its exact gain, or leaves the
+ * map once that is zero. Gains only shrink, so a top whose bound is exact is a
+ * set of maximum gain, and most sets never move at all.
+ *
+ * Stops when every coverable element is covered or max_sets sets are chosen,
+ * which makes it greedy maximum coverage.
+ *
+ * @param sets The elements of each set, each below element_count. Repeats within a set are ignored.
+ * @param element_count The number of elements.
+ * @param max_sets The most sets to choose.
+ *
+ * Throws std::invalid_argument if an element is out of range or there are more sets than fit in 32 bits.
+ */
+inline set_cover_result greedy_set_cover(const std::vector<std::vector<std::uint32_t>>& sets, std::size_t element_count,
+                                         std::size_t max_sets = std::numeric_limits<std::size_t>::max()) {
+    if (sets.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::invalid_argument("Too many sets for greedy_set_cover.");
+    }
+
+    // Invert to the sets containing each element, by counting sort. lastSeen
+    // counts repeats within a set once.
+    std::vector<std::size_t> offsets(element_count + 1, 0);
+    std::vector<std::uint32_t> lastSeen(element_count, std::numeric_limits<std::uint32_t>::max());
+    std::vector<long> gain(sets.size(), 0);
+    for (std::size_t s = 0; s < sets.size(); s++) {
+        for (auto e : sets[s]) {
+            if (e >= element_count) {
+                throw std::invalid_argument("Element out of range in greedy_set_cover.");
+            }
+            if (lastSeen[e] != s) {
+                lastSeen[e] = static_cast<std::uint32_t>(s);
+                offsets[e + 1]++;
+                gain[s]++;
+            }
+        }
+    }
+    for (std::size_t e = 0; e < element_count; e++) {
+        offsets[e + 1] += offsets[e];
+    }
+
+    std::vector<std::uint32_t> containing(offsets.back());
+    std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+    for (std::size_t s = 0; s < sets.size(); s++) {
+        for (auto e : sets[s]) {
+            // Filled slots of e end with s after its first occurrence in sets[s]
+            if (next[e] == offsets[e] || containing[next[e] - 1] != s) {
+                containing[next[e]++] = static_cast<std::uint32_t>(s);
+            }
+        }
+    }
+
+    std::vector<std::pair<std::uint32_t, long>> items;
+    for (std::size_t s = 0; s < sets.size(); s++) {
+        if (gain[s] > 0) {
+            items.emplace_back(static_cast<std::uint32_t>(s), gain[s]);
+        }
+    }
+    priority_map<std::uint32_t, long> remaining(items.begin(), items.end());
+
+    set_cover_result result;
+    std::vector<bool> covered(element_count, false);
+
+    while (!remaining.empty() && result.chosen.size() < max_sets) {
+        const auto [s, bound] = remaining.top();
+
+        // A stale top drops to its true gain and the pick is retried
+        if (bound != gain[s]) {
+            if (gain[s] == 0) {
+                remaining.erase(s);
+            }
+            else {
+                remaining[s] = gain[s];
+            }
+            continue;
+        }
+        remaining.pop();
+        result.chosen.push_back(s);
+        result.gains.push_back(static_cast<std::size_t>(gain[s]));
+        result.covered += static_cast<std::size_t>(gain[s]);
+
+        for (auto e : sets[s]) {
+            if (covered[e]) {
+                continue;
+            }
+            covered[e] = true;
+            for (std::size_t i = offsets[e]; i < offsets[e + 1]; i++) {
+                gain[containing[i]]--;
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_SET_COVER_HPP
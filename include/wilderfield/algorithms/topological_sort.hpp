@@ -0,0 +1,102 @@
+/**
+ * @file topological_sort.hpp
+ * @brief Level Topological Sort Definition
+ *
+ * Defines topological_sort, Kahn's algorithm over a min priority_map of
+ * indegrees that removes a whole level of ready nodes at a time.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_TOPOLOGICAL_SORT_HPP
+#define WILDERFIELD_ALGORITHMS_TOPOLOGICAL_SORT_HPP
+
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Result of topological_sort.
+ */
+struct topological_sort_result {
+    std::vector<csr_graph::node_type> order; ///< Nodes in topological order, level by level.
+    std::vector<std::size_t> level_offsets;  ///< Level l is order[level_offsets[l] .. level_offsets[l + 1]).
+    bool acyclic = true;                     ///< False if a cycle kept some nodes out of order.
+
+    std::size_t level_count() const { return level_offsets.size() - 1; } ///< Returns the number of levels.
+};
+
+/**
+ * @brief Sorts a directed graph topologically, grouping nodes into levels.
+ *
+ * Level 0 holds the nodes without incoming edges, and level l + 1 the nodes
+ * whose last predecessor is in level l. Each level is taken from the map as a
+ * whole zero-indegree bucket, and only then are its out-edges decremented, so
+ * nodes reaching zero meanwhile wait for the next level. Nodes within a level
+ * are in no particular order.
+ *
+ * Indegrees are counted down in a plain array, and the map is only told when a
+ * node reaches zero. Its other values are stale upper bounds, which is enough:
+ * the top is zero exactly when some node is ready. Each node so changes bucket
+ * at most once instead of once per incoming edge.
+ *
+ * When the graph has a cycle, the nodes on or after it never reach indegree
+ * zero. The result then has acyclic set to false and order holds only the
+ * nodes sorted before the cycle was hit.
+ */
+inline topological_sort_result topological_sort(const csr_graph& graph) {
+    using node_type = csr_graph::node_type;
+    const std::size_t n = graph.node_count();
+
+    std::vector<long> indegree(n, 0);
+    for (auto v : graph.targets()) {
+        indegree[v]++;
+    }
+    std::vector<std::pair<node_type, long>> items(n);
+    for (std::size_t u = 0; u < n; u++) {
+        items[u] = {static_cast<node_type>(u), indegree[u]};
+    }
+    priority_map<node_type, long, std::less<long>> remaining(items.begin(), items.end());
+
+    topological_sort_result result;
+    result.order.reserve(n);
+    result.level_offsets.push_back(0);
+
+    std::vector<node_type> ready;
+
+    while (!remaining.empty()) {
+        if (remaining.top().second != 0) {
+            result.acyclic = false;
+            break;
+        }
+
+        const std::size_t begin = result.order.size();
+        remaining.pop_top_bucket(std::back_inserter(result.order));
+
+        // Count down in the plain array, and only move a node once it is ready
+        for (std::size_t i = begin; i < result.order.size(); i++) {
+            for (auto v : graph.neighbors(result.order[i])) {
+                if (--indegree[v] == 0) {
+                    ready.push_back(v);
+                }
+            }
+        }
+        for (auto v : ready) {
+            remaining[v] = 0;
+        }
+        ready.clear();
+        result.level_offsets.push_back(result.order.size());
+    }
+    return result;
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_TOPOLOGICAL_SORT_HPP
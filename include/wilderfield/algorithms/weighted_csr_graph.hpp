@@ -0,0 +1,109 @@
+/**
+ * @file weighted_csr_graph.hpp
+ * @brief Weighted Compressed Sparse Row Graph Template Class Definition
+ *
+ * Defines a csr_graph with a weight per stored edge, kept in a second array
+ * aligned with the target array.
+ */
+
+#ifndef WILDERFIELD_ALGORITHMS_WEIGHTED_CSR_GRAPH_HPP
+#define WILDERFIELD_ALGORITHMS_WEIGHTED_CSR_GRAPH_HPP
+
+#include "wilderfield/algorithms/csr_graph.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+namespace algorithms {
+
+/**
+ * @brief Weighted compressed sparse row graph class
+ *
+ * The weight of the edge stored at targets()[e] is weights()[e], so the
+ * weights of node u's out-edges are weights()[offsets()[u] .. offsets()[u + 1]).
+ *
+ * @tparam Weight The type of the edge weights.
+ */
+template<typename Weight>
+class weighted_csr_graph final {
+
+public:
+    using node_type = csr_graph::node_type; ///< Type of the node ids.
+    using weight_type = Weight;             ///< Type of the edge weights.
+    using edge_type = std::tuple<node_type, node_type, Weight>; ///< Source, target and weight of an input edge.
+
+    /**
+     * @brief Contiguous range of edge weights, usable in range-based for loops.
+     */
+    struct weight_range {
+        const Weight* first;
+        const Weight* last;
+
+        const Weight* begin() const { return first; }
+        const Weight* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    };
+
+private:
+    csr_graph graph_;
+    std::vector<Weight> weights_; ///< Edge weights aligned with graph_.targets().
+
+public:
+
+    weighted_csr_graph() = default;
+
+    weighted_csr_graph(csr_graph graph, std::vector<Weight> weights); ///< Adopts a graph and its aligned weights. Throws std::invalid_argument if the sizes differ.
+
+    weighted_csr_graph(std::size_t nodes, const std::vector<edge_type>& edges, bool undirected = false); ///< Builds from an edge list, adding the reverse of each edge when undirected. Edges of a node keep their input order.
+
+    const csr_graph& graph() const { return graph_; } ///< Returns the unweighted graph.
+
+    std::size_t node_count() const { return graph_.node_count(); } ///< Returns the number of nodes.
+
+    std::size_t edge_count() const { return graph_.edge_count(); } ///< Returns the number of stored (directed) edges.
+
+    csr_graph::neighbor_range neighbors(node_type u) const { return graph_.neighbors(u); } ///< Returns the out-neighbors of u.
+
+    weight_range weights(node_type u) const { return {weights_.data() + graph_.offsets()[u], weights_.data() + graph_.offsets()[u + 1]}; } ///< Returns the weights of u's out-edges, aligned with neighbors(u).
+
+    const std::vector<Weight>& weights() const { return weights_; } ///< Returns the weight array.
+};
+
+// Out-of-line implementation of weighted_csr_graph methods
+
+template<typename Weight>
+weighted_csr_graph<Weight>::weighted_csr_graph(csr_graph graph, std::vector<Weight> weights)
+    : graph_(std::move(graph)), weights_(std::move(weights)) {
+    if (weights_.size() != graph_.edge_count()) {
+        throw std::invalid_argument("Weights don't match the edges of weighted_csr_graph.");
+    }
+}
+
+template<typename Weight>
+weighted_csr_graph<Weight>::weighted_csr_graph(std::size_t nodes, const std::vector<edge_type>& edges, bool undirected) {
+    std::vector<std::pair<node_type, node_type>> pairs;
+    pairs.reserve(edges.size());
+    for (const auto& [from, to, weight] : edges) {
+        pairs.emplace_back(from, to);
+    }
+    graph_ = csr_graph(nodes, pairs, undirected);
+
+    // Place the weights in the same stable order csr_graph placed the targets
+    weights_.resize(graph_.edge_count());
+    std::vector<std::size_t> next(graph_.offsets().begin(), graph_.offsets().end() - 1);
+    for (const auto& [from, to, weight] : edges) {
+        weights_[next[from]++] = weight;
+        if (undirected) {
+            weights_[next[to]++] = weight;
+        }
+    }
+}
+
+} // namespace algorithms
+} // namespace wilderfield
+
+#endif // WILDERFIELD_ALGORITHMS_WEIGHTED_CSR_GRAPH_HPP
@@ -0,0 +1,321 @@
+/**
+ * @file fixed_priority_map.hpp
+ * @brief Fixed Capacity Priority Map Template Class Definition
+ *
+ * Defines a fixed capacity priority map over the dense key range [0, Capacity).
+ * All storage lives inline in the object and every member function is
+ * constexpr, so the map can be used inside constant expressions.
+ */
+
+#ifndef WILDERFIELD_FIXED_PRIORITY_MAP_HPP
+#define WILDERFIELD_FIXED_PRIORITY_MAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace wilderfield {
+
+/**
+ * @brief Fixed capacity priority map class
+ *
+ * Implements the same bucketed design as priority_map, but keys are the
+ * integers [0, Capacity) and all nodes are carved from fixed size arrays.
+ * Values are kept in a sorted doubly linked list of nodes, and each value node
+ * heads an intrusive list of the keys holding that value. No member function
+ * allocates, so the whole map is usable in constant expressions.
+ *
+ * @tparam ValType The type of the values (priorities), must be numeric.
+ * @tparam Capacity The number of keys, keys must be smaller than Capacity.
+ * @tparam Compare Comparison class used to maintain the ordering of values.
+ */
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare = std::greater<ValType>
+>
+class fixed_priority_map final {
+
+static_assert(std::is_arithmetic<ValType>::value, "ValType must be a numeric type.");
+static_assert(Capacity > 0, "Capacity must be positive.");
+
+private:
+    static constexpr std::size_t npos = Capacity; ///< Sentinel index for "no node".
+
+    Compare comp_;
+
+    // Value nodes, at most one per distinct value and so at most Capacity of them.
+    std::array<ValType, Capacity> vals_{};          ///< Value held by each value node.
+    std::array<std::size_t, Capacity> valPrev_{};   ///< Previous value node in sorted order.
+    std::array<std::size_t, Capacity> valNext_{};   ///< Next value node in sorted order, or next free node.
+    std::array<std::size_t, Capacity> bucketHead_{}; ///< First key holding each value.
+
+    std::size_t valHead_ = npos; ///< Value node with the highest priority.
+    std::size_t freeVal_ = 0;    ///< Head of the free list of value nodes.
+
+    // Key nodes, indexed by key.
+    std::array<std::size_t, Capacity> keyNode_{}; ///< Value node of each key, npos if absent.
+    std::array<std::size_t, Capacity> keyPrev_{}; ///< Previous key in the same bucket.
+    std::array<std::size_t, Capacity> keyNext_{}; ///< Next key in the same bucket.
+
+    std::size_t size_ = 0;
+
+    // Private member functions
+
+    // Unlink key from its bucket, release the value node if it became empty.
+    // Returns the neighbours of the key's old position in the value list.
+    constexpr std::pair<std::size_t, std::size_t> detach(std::size_t key);
+
+    // Link key into the bucket for newVal, searching outwards from (prev, next).
+    constexpr void attach(std::size_t key, const ValType& newVal, std::size_t prev, std::size_t next);
+
+    // Update Key with Val
+    // This function can be used for increment, decrement, or assigning a new val
+    constexpr void update(std::size_t key, const ValType& newVal);
+
+    // Get the value associated with a key.
+    constexpr ValType getVal(std::size_t key) const { return vals_[keyNode_[key]]; }
+
+public:
+
+    constexpr fixed_priority_map() {
+        for (std::size_t i = 0; i < Capacity; i++) {
+            keyNode_[i] = npos;
+            valNext_[i] = i + 1; // Thread all value nodes onto the free list
+        }
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; } ///< Returns the maximum number of keys.
+
+    constexpr std::size_t size() const { return size_; } ///< Returns the number of unique keys in the priority map.
+
+    constexpr bool empty() const { return size_ == 0; } ///< Checks whether the priority map is empty.
+
+    constexpr std::size_t count(std::size_t key) const { return key < Capacity && keyNode_[key] != npos; } ///< Returns the count of a particular key in the map.
+
+    constexpr std::pair<std::size_t, ValType> top() const; ///< Returns the top element (key-value pair) in the priority map.
+
+    constexpr std::size_t erase(std::size_t key); ///< Erases key from the priority map. Returns the number of elements removed (0 or 1).
+
+    constexpr void pop(); ///< Removes the top element from the priority map.
+
+    class Proxy;
+    constexpr Proxy operator[](std::size_t key);
+
+    // Proxy class to handle the increment operation.
+    class Proxy {
+    private:
+        fixed_priority_map* pm;
+        std::size_t key;
+
+    public:
+        constexpr Proxy(fixed_priority_map* pm, std::size_t key) : pm(pm), key(key) {}
+
+        constexpr Proxy& operator++() {
+            pm->update(key, pm->getVal(key)+1);
+            return *this;
+        }
+
+        constexpr Proxy operator++(int) {
+            Proxy temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        constexpr Proxy& operator--() {
+            pm->update(key, pm->getVal(key)-1);
+            return *this;
+        }
+
+        constexpr Proxy operator--(int) {
+            Proxy temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        constexpr void operator=(const ValType& val) {pm->update(key, val);}
+
+        constexpr operator ValType() const {return pm->getVal(key);}
+    };
+
+};
+
+// Out-of-line implementation of fixed_priority_map methods
+
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare
+>
+constexpr std::pair<std::size_t, std::size_t> fixed_priority_map<ValType, Capacity, Compare>::detach(std::size_t key) {
+
+    const std::size_t node = keyNode_[key];
+
+    // Remove the key from its bucket
+    if (keyPrev_[key] != npos) {
+        keyNext_[keyPrev_[key]] = keyNext_[key];
+    }
+    else {
+        bucketHead_[node] = keyNext_[key];
+    }
+    if (keyNext_[key] != npos) {
+        keyPrev_[keyNext_[key]] = keyPrev_[key];
+    }
+    keyNode_[key] = npos;
+
+    // Keep the node as the search origin while other keys still hold its value
+    if (bucketHead_[node] != npos) {
+        return {node, valNext_[node]};
+    }
+
+    // Remove the node from the value list and return it to the free list
+    const std::size_t prev = valPrev_[node];
+    const std::size_t next = valNext_[node];
+    if (prev != npos) {
+        valNext_[prev] = next;
+    }
+    else {
+        valHead_ = next;
+    }
+    if (next != npos) {
+        valPrev_[next] = prev;
+    }
+    valNext_[node] = freeVal_;
+    freeVal_ = node;
+
+    return {prev, next};
+}
+
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare
+>
+constexpr void fixed_priority_map<ValType, Capacity, Compare>::attach(std::size_t key, const ValType& newVal, std::size_t prev, std::size_t next) {
+
+    // Linear search towards begin
+    while (prev != npos && comp_(newVal, vals_[prev])) {
+        next = prev;
+        prev = valPrev_[prev];
+    }
+
+    // Linear search towards end
+    while (next != npos && comp_(vals_[next], newVal)) {
+        prev = next;
+        next = valNext_[next];
+    }
+
+    std::size_t node = npos;
+    if (prev != npos && vals_[prev] == newVal) {
+        node = prev;
+    }
+    else if (next != npos && vals_[next] == newVal) {
+        node = next;
+    }
+    else {
+        // Carve a new value node from the free list and link it between prev and next
+        node = freeVal_;
+        freeVal_ = valNext_[node];
+        vals_[node] = newVal;
+        bucketHead_[node] = npos;
+        valPrev_[node] = prev;
+        valNext_[node] = next;
+        if (prev != npos) {
+            valNext_[prev] = node;
+        }
+        else {
+            valHead_ = node;
+        }
+        if (next != npos) {
+            valPrev_[next] = node;
+        }
+    }
+
+    // Push the key onto the front of the bucket
+    keyNode_[key] = node;
+    keyPrev_[key] = npos;
+    keyNext_[key] = bucketHead_[node];
+    if (bucketHead_[node] != npos) {
+        keyPrev_[bucketHead_[node]] = key;
+    }
+    bucketHead_[node] = key;
+}
+
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare
+>
+constexpr void fixed_priority_map<ValType, Capacity, Compare>::update(std::size_t key, const ValType& newVal) {
+
+    if (getVal(key) == newVal) return;
+
+    const auto neighbours = detach(key);
+    attach(key, newVal, neighbours.first, neighbours.second);
+}
+
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare
+>
+constexpr std::size_t fixed_priority_map<ValType, Capacity, Compare>::erase(std::size_t key) {
+    if (!count(key)) {
+        return 0;
+    }
+    detach(key);
+    size_--;
+    return 1;
+}
+
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare
+>
+constexpr std::pair<std::size_t, ValType> fixed_priority_map<ValType, Capacity, Compare>::top() const {
+    if (valHead_ == npos) {
+        throw std::out_of_range("Can't access top on an empty fixed_priority_map.");
+    }
+    // Return a pair consisting of one of the keys and the value.
+    return {bucketHead_[valHead_], vals_[valHead_]};
+}
+
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare
+>
+constexpr void fixed_priority_map<ValType, Capacity, Compare>::pop() {
+    if (valHead_ == npos) {
+        throw std::out_of_range("Can't pop from empty fixed_priority_map.");
+    }
+    detach(bucketHead_[valHead_]);
+    size_--;
+}
+
+template<
+    typename ValType,
+    std::size_t Capacity,
+    typename Compare
+>
+constexpr typename fixed_priority_map<ValType, Capacity, Compare>::Proxy fixed_priority_map<ValType, Capacity, Compare>::operator[](std::size_t key) {
+
+    if (key >= Capacity) {
+        throw std::out_of_range("Key exceeds the capacity of the fixed_priority_map.");
+    }
+
+    // If the key doesn't exist, create a new node with value 0
+    if (keyNode_[key] == npos) {
+        attach(key, 0, npos, valHead_);
+        size_++;
+    }
+    return Proxy(this, key);
+}
+
+} // namespace
+
+#endif // WILDERFIELD_FIXED_PRIORITY_MAP_HPP
@@ -0,0 +1,294 @@
+/**
+ * @file frozen_priority_map.hpp
+ * @brief Frozen Priority Map Template Class Definition
+ *
+ * Defines an immutable, compact priority map for data that is only queried
+ * once built, and freeze() to produce one from a priority_map.
+ */
+
+#ifndef WILDERFIELD_FROZEN_PRIORITY_MAP_HPP
+#define WILDERFIELD_FROZEN_PRIORITY_MAP_HPP
+
+#include "wilderfield/minimal_perfect_hash.hpp"
+#include "wilderfield/priority_map.hpp"
+#include "wilderfield/rank_select_bitvector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+
+/**
+ * @brief Frozen priority map class
+ *
+ * Keeps the keys in priority order in a single array. The distinct values are
+ * stored once each, and a rank/select bitvector marks where each value's run of
+ * keys starts, so the value at a position is a rank query and the first
+ * position of a value is a select query. A minimal perfect hash over the keys
+ * indexes a table of positions, and comparing the key stored at that position
+ * rejects keys outside the map, so no key is stored twice. A key whose Hash
+ * value equals that of an earlier key cannot get a perfect hash index, and
+ * such keys alone are kept in a small hash table of positions. Keys with equal
+ * values are in no particular order.
+ *
+ * @tparam KeyType The type of the keys.
+ * @tparam ValType The type of the values (priorities), must be numeric.
+ * @tparam Compare Comparison class used to maintain the ordering of values.
+ * @tparam Hash Hashing class used for keys.
+ */
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare = std::greater<ValType>,
+    typename Hash = std::hash<KeyType>
+>
+class frozen_priority_map final {
+
+static_assert(std::is_arithmetic<ValType>::value, "ValType must be a numeric type.");
+
+private:
+    Compare comp_;
+
+    std::vector<KeyType> keys_;                ///< Keys in priority order.
+    std::vector<ValType> vals_;                ///< Distinct values in priority order.
+    rank_select_bitvector runs_;               ///< Set at the first position of each value's run.
+    minimal_perfect_hash<KeyType, Hash> hash_; ///< Index of each key in positions_.
+    std::vector<std::uint32_t> positions_;     ///< Position in keys_ of the key with each hash index.
+    std::unordered_map<KeyType, std::uint32_t, Hash> colliding_; ///< Position of each key whose Hash value an earlier key took.
+
+    // Position of key in keys_, or keys_.size() if key is absent.
+    size_t positionOf(const KeyType& key) const {
+        if (keys_.empty()) {
+            return 0;
+        }
+        const std::uint32_t pos = positions_[hash_(key)];
+        if (keys_[pos] == key) {
+            return pos;
+        }
+        if (colliding_.empty()) {
+            return keys_.size();
+        }
+        auto it = colliding_.find(key);
+        return it == colliding_.end() ? keys_.size() : it->second;
+    }
+
+public:
+
+    frozen_priority_map() = default;
+
+    template<typename InputIt>
+    frozen_priority_map(InputIt first, InputIt last); ///< Builds from the (key, value) pairs in [first, last). Throws std::invalid_argument on duplicate keys.
+
+    size_t size() const { return keys_.size(); } ///< Returns the number of unique keys.
+
+    bool empty() const { return keys_.empty(); } ///< Checks whether the map is empty.
+
+    bool contains(const KeyType& key) const { return positionOf(key) != keys_.size(); } ///< Checks whether key is in the map.
+
+    std::optional<ValType> value(const KeyType& key) const; ///< Returns the value of key, or std::nullopt if key is absent.
+
+    std::optional<size_t> rank(const KeyType& key) const; ///< Returns the position of key in priority order, or std::nullopt if key is absent.
+
+    std::pair<KeyType, ValType> at_rank(size_t pos) const; ///< Returns the element at position pos in priority order. Throws std::out_of_range past the end.
+
+    std::pair<KeyType, ValType> top() const { return at_rank(0); } ///< Returns the top element (key-value pair).
+
+    std::vector<std::pair<KeyType, ValType>> top_k(size_t k) const; ///< Returns up to k elements with the highest priority, in priority order.
+
+    std::vector<std::pair<KeyType, ValType>> range(const ValType& a, const ValType& b) const; ///< Returns the elements with values between a and b inclusive, in priority order.
+
+    size_t memory_bytes() const; ///< Returns an estimate of the heap memory used.
+};
+
+/**
+ * @brief Builds a frozen_priority_map holding the current contents of pmap.
+ */
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+frozen_priority_map<KeyType, ValType, Compare, Hash> freeze(const priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>& pmap) {
+    auto items = pmap.top_k(pmap.size());
+    return frozen_priority_map<KeyType, ValType, Compare, Hash>(items.begin(), items.end());
+}
+
+// Out-of-line implementation of frozen_priority_map methods
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+template<typename InputIt>
+frozen_priority_map<KeyType, ValType, Compare, Hash>::frozen_priority_map(InputIt first, InputIt last) {
+    std::vector<std::pair<KeyType, ValType>> items(first, last);
+    if (items.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("Too many keys for frozen_priority_map.");
+    }
+
+    // freeze() hands over items already in priority order
+    auto byPriority = [this](const std::pair<KeyType, ValType>& a, const std::pair<KeyType, ValType>& b) {
+        return comp_(a.second, b.second);
+    };
+    if (!std::is_sorted(items.begin(), items.end(), byPriority)) {
+        std::stable_sort(items.begin(), items.end(), byPriority);
+    }
+
+    keys_.reserve(items.size());
+    std::vector<bool> starts(items.size(), false);
+    for (size_t i = 0; i < items.size(); i++) {
+        keys_.push_back(items[i].first);
+        if (i == 0 || items[i].second != items[i - 1].second) {
+            starts[i] = true;
+            vals_.push_back(items[i].second);
+        }
+    }
+    vals_.shrink_to_fit();
+    runs_ = rank_select_bitvector(starts);
+
+    // The first key of each Hash value gets a perfect hash index, later ones
+    // are either duplicates or go to colliding_
+    const Hash hash;
+    std::unordered_map<std::size_t, std::uint32_t> firstOfHash(keys_.size());
+    std::vector<std::uint32_t> indexed;
+    indexed.reserve(keys_.size());
+    for (size_t i = 0; i < keys_.size(); i++) {
+        const auto [it, first] = firstOfHash.emplace(static_cast<std::size_t>(hash(keys_[i])), static_cast<std::uint32_t>(i));
+        if (first) {
+            indexed.push_back(static_cast<std::uint32_t>(i));
+        }
+        else if (keys_[it->second] == keys_[i] || !colliding_.emplace(keys_[i], static_cast<std::uint32_t>(i)).second) {
+            throw std::invalid_argument("Duplicate key in frozen_priority_map.");
+        }
+    }
+
+    std::vector<KeyType> hashed;
+    hashed.reserve(indexed.size());
+    for (auto pos : indexed) {
+        hashed.push_back(keys_[pos]);
+    }
+    hash_ = minimal_perfect_hash<KeyType, Hash>(hashed.begin(), hashed.end(), hash);
+    positions_.resize(indexed.size());
+    for (auto pos : indexed) {
+        positions_[hash_(keys_[pos])] = pos;
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::optional<ValType> frozen_priority_map<KeyType, ValType, Compare, Hash>::value(const KeyType& key) const {
+    const size_t pos = positionOf(key);
+    if (pos == keys_.size()) {
+        return std::nullopt;
+    }
+    return vals_[runs_.rank(pos + 1) - 1];
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::optional<size_t> frozen_priority_map<KeyType, ValType, Compare, Hash>::rank(const KeyType& key) const {
+    const size_t pos = positionOf(key);
+    if (pos == keys_.size()) {
+        return std::nullopt;
+    }
+    return pos;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::pair<KeyType, ValType> frozen_priority_map<KeyType, ValType, Compare, Hash>::at_rank(size_t pos) const {
+    if (pos >= keys_.size()) {
+        throw std::out_of_range("Position out of range in frozen_priority_map.");
+    }
+    return {keys_[pos], vals_[runs_.rank(pos + 1) - 1]};
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::vector<std::pair<KeyType, ValType>> frozen_priority_map<KeyType, ValType, Compare, Hash>::top_k(size_t k) const {
+    std::vector<std::pair<KeyType, ValType>> result;
+    result.reserve(std::min(k, keys_.size()));
+
+    // Walk the runs instead of ranking every position
+    for (size_t run = 0; run < vals_.size() && result.size() < k; run++) {
+        const size_t begin = runs_.select(run);
+        const size_t end = std::min(runs_.select(run + 1), begin + (k - result.size()));
+        for (size_t pos = begin; pos < end; pos++) {
+            result.emplace_back(keys_[pos], vals_[run]);
+        }
+    }
+    return result;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::vector<std::pair<KeyType, ValType>> frozen_priority_map<KeyType, ValType, Compare, Hash>::range(const ValType& a, const ValType& b) const {
+
+    // Runs are in priority order, so the matching ones are contiguous
+    const ValType& first = comp_(b, a) ? b : a;
+    const ValType& last = comp_(b, a) ? a : b;
+    const size_t beginRun = std::lower_bound(vals_.begin(), vals_.end(), first, comp_) - vals_.begin();
+    const size_t endRun = std::upper_bound(vals_.begin(), vals_.end(), last, comp_) - vals_.begin();
+
+    std::vector<std::pair<KeyType, ValType>> result;
+    for (size_t run = beginRun; run < endRun; run++) {
+        const size_t end = runs_.select(run + 1);
+        for (size_t pos = runs_.select(run); pos < end; pos++) {
+            result.emplace_back(keys_[pos], vals_[run]);
+        }
+    }
+    return result;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+size_t frozen_priority_map<KeyType, ValType, Compare, Hash>::memory_bytes() const {
+    return keys_.capacity() * sizeof(KeyType)
+        + vals_.capacity() * sizeof(ValType)
+        + runs_.memory_bytes()
+        + hash_.memory_bytes()
+        + positions_.capacity() * sizeof(std::uint32_t)
+        + colliding_.size() * (sizeof(std::pair<const KeyType, std::uint32_t>) + sizeof(void*))
+        + (colliding_.empty() ? 0 : colliding_.bucket_count() * sizeof(void*));
+}
+
+} // namespace
+
+#endif // WILDERFIELD_FROZEN_PRIORITY_MAP_HPP
@@ -0,0 +1,315 @@
+/**
+ * @file hot_cache_map.hpp
+ * @brief Hot Key Cache Map Template Class Definition
+ *
+ * Defines a hash map with a small direct-mapped cache in front of it, so that
+ * repeated lookups of the same few keys skip the full hash table probe.
+ */
+
+#ifndef WILDERFIELD_HOT_CACHE_MAP_HPP
+#define WILDERFIELD_HOT_CACHE_MAP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+
+/**
+ * @brief Hot key cache map class
+ *
+ * Wraps a std::unordered_map and remembers, per cache slot, a pointer to the
+ * entry most recently looked up through that slot. Entries of std::unordered_map
+ * never move, so a cached pointer stays valid until its key is erased, at which
+ * point the slot is cleared. A hit costs one hash, one multiply and one key
+ * comparison. Hits and misses are counted for tuning the cache size.
+ *
+ * Only non-const lookups fill the cache. A const find() reads it and counts
+ * the outcome in relaxed atomics, so concurrent const lookups are as safe as
+ * on std::unordered_map.
+ *
+ * Satisfies the key index requirements of priority_map.
+ *
+ * @tparam KeyType The type of the keys.
+ * @tparam Mapped The type of the mapped values.
+ * @tparam Hash Hashing class used for keys.
+ * @tparam Allocator Allocator for the entries, rebound as needed.
+ */
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash = std::hash<KeyType>,
+    typename Allocator = std::allocator<std::pair<const KeyType, Mapped>>
+>
+class hot_cache_map final {
+
+public:
+    using value_type = std::pair<const KeyType, Mapped>; ///< Type of the entries.
+    using iterator = value_type*;                        ///< Iterator to an entry, nullptr is end().
+    using const_iterator = const value_type*;            ///< Const iterator to an entry, nullptr is end().
+
+    static constexpr std::size_t default_cache_slots = 256; ///< Cache slots used by the default constructor.
+
+private:
+    Hash hash_;
+    std::unordered_map<KeyType, Mapped, Hash, std::equal_to<KeyType>,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>> map_; ///< Backing hash table holding every entry.
+
+    std::vector<value_type*> cache_; ///< Direct-mapped cache of entries, nullptr when empty.
+    unsigned shift_ = 0;             ///< Right shift selecting the cache slot bits.
+
+    mutable std::atomic<std::uint64_t> hits_{0};   ///< Lookups answered by the cache.
+    mutable std::atomic<std::uint64_t> misses_{0}; ///< Lookups that probed the backing table.
+
+    // Counts a lookup from a non-const member. Those never run alongside other
+    // members, so a plain load and store will do instead of a locked add.
+    static void tally(std::atomic<std::uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Cache slot of a key, using the top bits of a Fibonacci hash.
+    std::size_t slotOf(const KeyType& key) const {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(hash_(key)) * 0x9e3779b97f4a7c15ULL) >> shift_);
+    }
+
+public:
+
+    explicit hot_cache_map(std::size_t cacheSlots = default_cache_slots, const Hash& hash = Hash()); ///< Constructs an empty map with at least cacheSlots cache slots, rounded up to a power of two.
+
+    hot_cache_map(const hot_cache_map& other); ///< Copies the entries, starting with a cold cache since cached pointers refer to other's entries.
+
+    hot_cache_map& operator=(const hot_cache_map& other); ///< Copies the entries, starting with a cold cache since cached pointers refer to other's entries.
+
+    hot_cache_map(hot_cache_map&& other); ///< Takes other's entries and cache, which stay valid since the entries don't move. Leaves other empty with a cold cache.
+
+    hot_cache_map& operator=(hot_cache_map&& other); ///< Takes other's entries and cache, which stay valid since the entries don't move. Leaves other empty with a cold cache.
+
+    size_t size() const { return map_.size(); } ///< Returns the number of keys in the map.
+
+    bool empty() const { return map_.empty(); } ///< Checks whether the map is empty.
+
+    size_t cache_slots() const { return cache_.size(); } ///< Returns the number of cache slots.
+
+    std::uint64_t hits() const { return hits_.load(std::memory_order_relaxed); } ///< Returns the number of lookups answered by the cache.
+
+    std::uint64_t misses() const { return misses_.load(std::memory_order_relaxed); } ///< Returns the number of lookups that probed the backing table.
+
+    double hit_rate() const; ///< Returns the fraction of lookups answered by the cache.
+
+    void reset_stats(); ///< Resets the hit and miss counters.
+
+    iterator end() { return nullptr; } ///< Returns the past-the-end iterator.
+
+    const_iterator end() const { return nullptr; } ///< Returns the past-the-end iterator.
+
+    iterator find(const KeyType& key); ///< Returns an iterator to the entry for key, or end() if absent.
+
+    const_iterator find(const KeyType& key) const; ///< Returns an iterator to the entry for key, or end() if absent. Reads the cache but never fills it.
+
+    size_t count(const KeyType& key) const { return find(key) != end(); } ///< Returns the count of a particular key in the map.
+
+    std::pair<iterator, bool> try_emplace(const KeyType& key); ///< Returns the entry for key and whether it was inserted, inserting a default mapped value if absent.
+
+    Mapped& operator[](const KeyType& key) { return try_emplace(key).first->second; } ///< Returns the mapped value of key, inserting a default one if absent.
+
+    Mapped& at(const KeyType& key); ///< Returns the mapped value of key. Throws std::out_of_range if absent.
+
+    size_t erase(const KeyType& key); ///< Erases key from the map. Returns the number of elements removed (0 or 1).
+};
+
+// Out-of-line implementation of hot_cache_map methods
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+hot_cache_map<KeyType, Mapped, Hash, Allocator>::hot_cache_map(std::size_t cacheSlots, const Hash& hash) : hash_(hash), map_(0, hash) {
+    // At least two slots, since shifting by 64 would be undefined
+    unsigned bits = 1;
+    while ((std::size_t(1) << bits) < cacheSlots && bits < 63) {
+        bits++;
+    }
+    cache_.assign(std::size_t(1) << bits, nullptr);
+    shift_ = 64 - bits;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+hot_cache_map<KeyType, Mapped, Hash, Allocator>::hot_cache_map(const hot_cache_map& other)
+    : hash_(other.hash_), map_(other.map_), cache_(other.cache_.size(), nullptr), shift_(other.shift_) {}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+hot_cache_map<KeyType, Mapped, Hash, Allocator>& hot_cache_map<KeyType, Mapped, Hash, Allocator>::operator=(const hot_cache_map& other) {
+    if (this != &other) {
+        hash_ = other.hash_;
+        map_ = other.map_;
+        cache_.assign(other.cache_.size(), nullptr);
+        shift_ = other.shift_;
+    }
+    return *this;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+hot_cache_map<KeyType, Mapped, Hash, Allocator>::hot_cache_map(hot_cache_map&& other)
+    : hash_(std::move(other.hash_)), map_(std::move(other.map_)), cache_(std::move(other.cache_)), shift_(other.shift_),
+      hits_(other.hits()), misses_(other.misses()) {
+    // Leave other a valid, empty map with a cold cache of the same size
+    other.cache_.assign(cache_.size(), nullptr);
+    other.map_.clear();
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+hot_cache_map<KeyType, Mapped, Hash, Allocator>& hot_cache_map<KeyType, Mapped, Hash, Allocator>::operator=(hot_cache_map&& other) {
+    if (this != &other) {
+        hash_ = std::move(other.hash_);
+        map_ = std::move(other.map_);
+        cache_ = std::move(other.cache_);
+        shift_ = other.shift_;
+        hits_.store(other.hits(), std::memory_order_relaxed);
+        misses_.store(other.misses(), std::memory_order_relaxed);
+        other.cache_.assign(cache_.size(), nullptr);
+        other.map_.clear();
+    }
+    return *this;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+double hot_cache_map<KeyType, Mapped, Hash, Allocator>::hit_rate() const {
+    const std::uint64_t hits = this->hits();
+    const std::uint64_t lookups = hits + misses();
+    return lookups ? double(hits) / double(lookups) : 0.0;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+void hot_cache_map<KeyType, Mapped, Hash, Allocator>::reset_stats() {
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename hot_cache_map<KeyType, Mapped, Hash, Allocator>::const_iterator hot_cache_map<KeyType, Mapped, Hash, Allocator>::find(const KeyType& key) const {
+    const value_type* cached = cache_[slotOf(key)];
+    if (cached && cached->first == key) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return cached;
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+
+    auto it = map_.find(key);
+    return it == map_.end() ? nullptr : &*it;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename hot_cache_map<KeyType, Mapped, Hash, Allocator>::iterator hot_cache_map<KeyType, Mapped, Hash, Allocator>::find(const KeyType& key) {
+    value_type*& cached = cache_[slotOf(key)];
+    if (cached && cached->first == key) {
+        tally(hits_);
+        return cached;
+    }
+    tally(misses_);
+
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+        return nullptr;
+    }
+    cached = &*it;
+    return cached;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+std::pair<typename hot_cache_map<KeyType, Mapped, Hash, Allocator>::iterator, bool> hot_cache_map<KeyType, Mapped, Hash, Allocator>::try_emplace(const KeyType& key) {
+    value_type*& cached = cache_[slotOf(key)];
+    if (cached && cached->first == key) {
+        tally(hits_);
+        return {cached, false};
+    }
+    tally(misses_);
+
+    auto [it, inserted] = map_.try_emplace(key);
+    cached = &*it;
+    return {cached, inserted};
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+Mapped& hot_cache_map<KeyType, Mapped, Hash, Allocator>::at(const KeyType& key) {
+    auto it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("Key not found in hot_cache_map.");
+    }
+    return it->second;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+size_t hot_cache_map<KeyType, Mapped, Hash, Allocator>::erase(const KeyType& key) {
+    value_type*& cached = cache_[slotOf(key)];
+    if (cached && cached->first == key) {
+        cached = nullptr;
+    }
+    return map_.erase(key);
+}
+
+} // namespace
+
+#endif // WILDERFIELD_HOT_CACHE_MAP_HPP
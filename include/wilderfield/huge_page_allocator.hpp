@@ -0,0 +1,416 @@
+/**
+ * @file huge_page_allocator.hpp
+ * @brief Huge Page Arena and Allocator Definitions
+ *
+ * Defines an arena that carves small node allocations out of chunks backed by
+ * 2 MB huge pages, and an STL allocator drawing from it, so that large node
+ * based containers touch far fewer TLB entries.
+ */
+
+#ifndef WILDERFIELD_HUGE_PAGE_ALLOCATOR_HPP
+#define WILDERFIELD_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define WILDERFIELD_HAS_MMAP 1
+#endif
+
+namespace wilderfield {
+
+/**
+ * @brief Huge page arena class
+ *
+ * Reserves memory in chunks aligned to 2 MB. On Linux each chunk is first
+ * requested with MAP_HUGETLB, and when no huge pages are reserved it falls back
+ * to an ordinary mapping advised with MADV_HUGEPAGE for transparent huge pages.
+ * Other platforms get plain mappings, or aligned operator new without mmap.
+ *
+ * Requests up to 512 bytes are rounded to 16 byte size classes, and up to 1 MB
+ * to powers of two. Each class keeps a free list, so freed nodes are reused and
+ * chunk memory is only returned when the arena is destroyed. Larger requests get
+ * a mapping of their own that is released on deallocation. All member functions
+ * are thread safe, taking the arena's lock.
+ *
+ * huge_page_allocator reaches the global arena through a cache per thread that
+ * keeps a short free list per class, so most of its allocations and frees take
+ * no lock. A cache refills from the arena and spills back to it a batch of
+ * nodes at a time, and hands everything back when its thread exits.
+ */
+class huge_page_arena final {
+
+public:
+    static constexpr std::size_t huge_page_size = std::size_t(1) << 21; ///< Size of an x86-64 huge page.
+
+private:
+    static constexpr std::size_t smallStep_ = 16;                   ///< Granularity of the small size classes.
+    static constexpr std::size_t smallMax_ = 512;                   ///< Largest small size class.
+    static constexpr std::size_t mediumMax_ = huge_page_size / 2;   ///< Largest pooled request.
+    static constexpr std::size_t classes_ = smallMax_ / smallStep_ + 11; ///< Small classes plus powers of two 1 KB .. 1 MB.
+
+    struct Chunk {
+        void* base;
+        std::size_t size;
+        bool hugetlb; ///< Backed by explicitly reserved huge pages.
+    };
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    // Free lists a thread keeps for the global arena.
+    struct ThreadCache {
+        std::array<FreeNode*, classes_> free{};
+        std::array<std::size_t, classes_> count{};
+        bool retired = false; ///< Set once the thread is exiting, after which frees go to the arena.
+    };
+
+    // Hands a thread's cached nodes back to the global arena when the thread exits.
+    struct CacheRetirer {
+        ThreadCache& cache;
+        ~CacheRetirer();
+    };
+
+    std::mutex mutex_;
+    std::size_t chunkSize_;
+    std::vector<Chunk> chunks_;
+    char* cursor_ = nullptr;
+    std::size_t left_ = 0;
+    std::array<FreeNode*, classes_> free_{};
+
+    std::size_t hugetlbChunks_ = 0;
+    std::size_t reservedBytes_ = 0;
+
+    static std::size_t classOf(std::size_t bytes);
+    static std::size_t classSize(std::size_t cls);
+
+    // Nodes a thread cache moves at once, about 4 KB worth.
+    static std::size_t batchOf(std::size_t cls) { return std::max<std::size_t>(1, std::min<std::size_t>(32, 4096 / classSize(cls))); }
+
+    // Node of class cls from its free list or the current chunk. Requires the lock.
+    void* carve(std::size_t cls);
+
+    // Link n nodes of class cls into a list, returning its head.
+    FreeNode* takeBatch(std::size_t cls, std::size_t n);
+
+    // Return the list from head to tail to the free list of class cls.
+    void giveBatch(std::size_t cls, FreeNode* head, FreeNode* tail);
+
+    static ThreadCache& threadCache();
+
+    // Map size bytes (a multiple of huge_page_size) aligned to huge_page_size.
+    static Chunk map(std::size_t size);
+    static void unmap(const Chunk& chunk);
+
+public:
+
+    explicit huge_page_arena(std::size_t chunkSize = 32 * huge_page_size); ///< Constructs an arena that reserves chunkSize bytes at a time, rounded up to whole huge pages.
+
+    huge_page_arena(const huge_page_arena&) = delete;
+    huge_page_arena& operator=(const huge_page_arena&) = delete;
+    ~huge_page_arena();
+
+    void* allocate(std::size_t bytes); ///< Returns storage for bytes, aligned to 16 bytes. Throws std::bad_alloc on failure.
+
+    void deallocate(void* ptr, std::size_t bytes); ///< Returns storage obtained from allocate(bytes) to the arena.
+
+    std::size_t reserved_bytes(); ///< Returns the bytes currently mapped by the arena.
+
+    std::size_t hugetlb_chunks(); ///< Returns the number of pooled chunks backed by explicitly reserved huge pages.
+
+    static huge_page_arena& global(); ///< Returns the process wide arena used by huge_page_allocator.
+
+    static void* allocate_cached(std::size_t bytes); ///< Like global().allocate(bytes), usually served by the calling thread's cache without locking.
+
+    static void deallocate_cached(void* ptr, std::size_t bytes) noexcept; ///< Like global().deallocate(ptr, bytes), usually kept in the calling thread's cache without locking.
+};
+
+/**
+ * @brief Huge page allocator class
+ *
+ * Stateless STL allocator drawing from huge_page_arena::global() through the
+ * calling thread's cache. All instances compare equal, so containers can freely
+ * exchange nodes between them, and a node may be freed by another thread.
+ *
+ * @tparam T The type of the objects allocated.
+ */
+template<typename T>
+class huge_page_allocator {
+
+static_assert(alignof(T) <= 16, "huge_page_allocator only provides 16 byte alignment.");
+
+public:
+    using value_type = T;
+
+    huge_page_allocator() noexcept = default;
+
+    template<typename U>
+    huge_page_allocator(const huge_page_allocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(huge_page_arena::allocate_cached(n * sizeof(T))); }
+
+    void deallocate(T* ptr, std::size_t n) noexcept { huge_page_arena::deallocate_cached(ptr, n * sizeof(T)); }
+
+    template<typename U>
+    bool operator==(const huge_page_allocator<U>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const huge_page_allocator<U>&) const noexcept { return false; }
+};
+
+// Out-of-line implementation of huge_page_arena methods
+
+inline std::size_t huge_page_arena::classOf(std::size_t bytes) {
+    if (bytes <= smallMax_) {
+        return bytes == 0 ? 0 : (bytes - 1) / smallStep_;
+    }
+    std::size_t cls = smallMax_ / smallStep_;
+    for (std::size_t size = 2 * smallMax_; size < bytes; size *= 2) {
+        cls++;
+    }
+    return cls;
+}
+
+inline std::size_t huge_page_arena::classSize(std::size_t cls) {
+    if (cls < smallMax_ / smallStep_) {
+        return (cls + 1) * smallStep_;
+    }
+    return (2 * smallMax_) << (cls - smallMax_ / smallStep_);
+}
+
+inline huge_page_arena::Chunk huge_page_arena::map(std::size_t size) {
+#if defined(WILDERFIELD_HAS_MMAP)
+#if defined(MAP_HUGETLB)
+    // Explicit huge pages are only available when the administrator reserved some
+    void* huge = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (huge != MAP_FAILED) {
+        return {huge, size, true};
+    }
+#endif
+    // Over-reserve, then trim the ends so the chunk starts on a huge page boundary
+    const std::size_t padded = size + huge_page_size;
+    void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+    const auto aligned = (addr + huge_page_size - 1) & ~(std::uintptr_t(huge_page_size) - 1);
+    if (aligned != addr) {
+        ::munmap(raw, aligned - addr);
+    }
+    if (aligned + size != addr + padded) {
+        ::munmap(reinterpret_cast<void*>(aligned + size), addr + padded - aligned - size);
+    }
+#if defined(MADV_HUGEPAGE)
+    ::madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+    return {reinterpret_cast<void*>(aligned), size, false};
+#else
+    return {::operator new(size, std::align_val_t(huge_page_size)), size, false};
+#endif
+}
+
+inline void huge_page_arena::unmap(const Chunk& chunk) {
+#if defined(WILDERFIELD_HAS_MMAP)
+    ::munmap(chunk.base, chunk.size);
+#else
+    ::operator delete(chunk.base, std::align_val_t(huge_page_size));
+#endif
+}
+
+inline huge_page_arena::huge_page_arena(std::size_t chunkSize)
+    : chunkSize_((chunkSize + huge_page_size - 1) / huge_page_size * huge_page_size) {
+    if (chunkSize_ == 0) {
+        chunkSize_ = huge_page_size;
+    }
+}
+
+inline huge_page_arena::~huge_page_arena() {
+    for (const auto& chunk : chunks_) {
+        unmap(chunk);
+    }
+}
+
+inline void* huge_page_arena::allocate(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Oversized requests get a dedicated mapping
+    if (bytes > mediumMax_) {
+        const Chunk chunk = map((bytes + huge_page_size - 1) / huge_page_size * huge_page_size);
+        reservedBytes_ += chunk.size;
+        return chunk.base;
+    }
+
+    return carve(classOf(bytes));
+}
+
+inline void* huge_page_arena::carve(std::size_t cls) {
+    if (FreeNode* node = free_[cls]) {
+        free_[cls] = node->next;
+        return node;
+    }
+
+    const std::size_t size = classSize(cls);
+    if (size > left_) {
+        // The tail of the current chunk is abandoned, at most 1 MB
+        const Chunk chunk = map(chunkSize_);
+        chunks_.push_back(chunk);
+        hugetlbChunks_ += chunk.hugetlb;
+        reservedBytes_ += chunk.size;
+        cursor_ = static_cast<char*>(chunk.base);
+        left_ = chunk.size;
+    }
+    void* ptr = cursor_;
+    cursor_ += size;
+    left_ -= size;
+    return ptr;
+}
+
+inline void huge_page_arena::deallocate(void* ptr, std::size_t bytes) {
+    if (!ptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (bytes > mediumMax_) {
+        const Chunk chunk{ptr, (bytes + huge_page_size - 1) / huge_page_size * huge_page_size, false};
+        reservedBytes_ -= chunk.size;
+        unmap(chunk);
+        return;
+    }
+
+    const std::size_t cls = classOf(bytes);
+    auto* node = static_cast<FreeNode*>(ptr);
+    node->next = free_[cls];
+    free_[cls] = node;
+}
+
+inline huge_page_arena::FreeNode* huge_page_arena::takeBatch(std::size_t cls, std::size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Linked in carving order, so fresh nodes are handed out at rising addresses
+    FreeNode* head = static_cast<FreeNode*>(carve(cls));
+    FreeNode* tail = head;
+    tail->next = nullptr;
+    try {
+        for (std::size_t i = 1; i < n; i++) {
+            tail->next = static_cast<FreeNode*>(carve(cls));
+            tail = tail->next;
+            tail->next = nullptr;
+        }
+    }
+    catch (...) {
+        // Keep the nodes carved so far for later requests
+        tail->next = free_[cls];
+        free_[cls] = head;
+        throw;
+    }
+    return head;
+}
+
+inline void huge_page_arena::giveBatch(std::size_t cls, FreeNode* head, FreeNode* tail) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tail->next = free_[cls];
+    free_[cls] = head;
+}
+
+inline std::size_t huge_page_arena::reserved_bytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reservedBytes_;
+}
+
+inline std::size_t huge_page_arena::hugetlb_chunks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hugetlbChunks_;
+}
+
+inline huge_page_arena& huge_page_arena::global() {
+    // Never destroyed, containers with static storage may still free into it at exit
+    static huge_page_arena* arena = new huge_page_arena();
+    return *arena;
+}
+
+inline huge_page_arena::CacheRetirer::~CacheRetirer() {
+    cache.retired = true;
+    for (std::size_t cls = 0; cls < classes_; cls++) {
+        if (FreeNode* head = cache.free[cls]) {
+            FreeNode* tail = head;
+            while (tail->next) {
+                tail = tail->next;
+            }
+            global().giveBatch(cls, head, tail);
+            cache.free[cls] = nullptr;
+            cache.count[cls] = 0;
+        }
+    }
+}
+
+inline huge_page_arena::ThreadCache& huge_page_arena::threadCache() {
+    // The cache itself has no destructor, so frees during thread exit still find it
+    static thread_local ThreadCache cache;
+    static thread_local CacheRetirer retirer{cache};
+    return cache;
+}
+
+inline void* huge_page_arena::allocate_cached(std::size_t bytes) {
+    if (bytes > mediumMax_) {
+        return global().allocate(bytes);
+    }
+    ThreadCache& cache = threadCache();
+    if (cache.retired) {
+        return global().allocate(bytes);
+    }
+
+    const std::size_t cls = classOf(bytes);
+    if (!cache.free[cls]) {
+        cache.free[cls] = global().takeBatch(cls, batchOf(cls));
+        cache.count[cls] = batchOf(cls);
+    }
+    FreeNode* node = cache.free[cls];
+    cache.free[cls] = node->next;
+    cache.count[cls]--;
+    return node;
+}
+
+inline void huge_page_arena::deallocate_cached(void* ptr, std::size_t bytes) noexcept {
+    if (!ptr) {
+        return;
+    }
+    if (bytes > mediumMax_) {
+        global().deallocate(ptr, bytes);
+        return;
+    }
+    ThreadCache& cache = threadCache();
+    if (cache.retired) {
+        global().deallocate(ptr, bytes);
+        return;
+    }
+
+    const std::size_t cls = classOf(bytes);
+    auto* node = static_cast<FreeNode*>(ptr);
+    node->next = cache.free[cls];
+    cache.free[cls] = node;
+
+    // Spill a batch once the list holds two, so a thread that only frees stays bounded
+    const std::size_t batch = batchOf(cls);
+    if (++cache.count[cls] >= 2 * batch) {
+        FreeNode* tail = node;
+        for (std::size_t i = 1; i < batch; i++) {
+            tail = tail->next;
+        }
+        cache.free[cls] = tail->next;
+        cache.count[cls] -= batch;
+        global().giveBatch(cls, node, tail);
+    }
+}
+
+} // namespace
+
+#endif // WILDERFIELD_HUGE_PAGE_ALLOCATOR_HPP
@@ -0,0 +1,428 @@
+/**
+ * @file incremental_hash_map.hpp
+ * @brief Incremental Rehashing Hash Map Template Class Definition
+ *
+ * Defines a chained hash map that grows by migrating a few buckets per
+ * operation from the old table to the new one, instead of rehashing every
+ * entry in a single call.
+ */
+
+#ifndef WILDERFIELD_INCREMENTAL_HASH_MAP_HPP
+#define WILDERFIELD_INCREMENTAL_HASH_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace wilderfield {
+
+/**
+ * @brief Incremental rehashing hash map class
+ *
+ * Keeps two bucket tables while growing, in the style of Redis' dict. Once the
+ * load factor reaches one, a table of twice the size is allocated and every
+ * later operation moves a few buckets from the old table to the new one. Lookups
+ * consult both tables until the old one is drained. Each operation does a small,
+ * bounded amount of rehashing work rather than an occasional full rehash.
+ * Bucket arrays come from calloc, so large tables get lazily zeroed pages, and
+ * nodes come from Allocator.
+ *
+ * Entries are individually allocated nodes that never move, so iterators stay
+ * valid until their entry is erased. Satisfies the key index requirements of
+ * priority_map.
+ *
+ * @tparam KeyType The type of the keys.
+ * @tparam Mapped The type of the mapped values, must be default constructible.
+ * @tparam Hash Hashing class used for keys.
+ * @tparam Allocator Allocator for the entries, rebound as needed.
+ */
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash = std::hash<KeyType>,
+    typename Allocator = std::allocator<std::pair<const KeyType, Mapped>>
+>
+class incremental_hash_map final {
+
+public:
+    using value_type = std::pair<const KeyType, Mapped>; ///< Type of the entries.
+    using iterator = value_type*;                        ///< Iterator to an entry, nullptr is end().
+    using const_iterator = const value_type*;            ///< Const iterator to an entry, nullptr is end().
+
+private:
+    static constexpr std::size_t migrateBuckets_ = 4; ///< Non-empty buckets migrated per operation.
+    static constexpr unsigned minBits_ = 3;           ///< Log2 of the initial bucket count.
+
+    struct Node {
+        value_type value;
+        std::uint64_t hash; ///< Mixed hash, kept so migration never rehashes keys.
+        Node* next;
+    };
+
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    struct Table {
+        Node** buckets = nullptr;
+        unsigned bits = 0;
+
+        std::size_t size() const { return buckets ? std::size_t(1) << bits : 0; }
+        std::size_t index(std::uint64_t hash) const { return static_cast<std::size_t>(hash >> (64 - bits)); }
+    };
+
+    Hash hash_;
+    Table tables_[2];          ///< tables_[0] is the live table, tables_[1] the one being grown into.
+    std::size_t migrated_ = 0; ///< Buckets of tables_[0] already moved while rehashing.
+    std::size_t size_ = 0;
+
+    std::uint64_t hashKey(const KeyType& key) const {
+        return static_cast<std::uint64_t>(hash_(key)) * 0x9e3779b97f4a7c15ULL; // Fibonacci hashing, top bits index
+    }
+
+    static Table allocate(unsigned bits);
+    static void release(Table& table);
+
+    static Node* createNode(const KeyType& key, std::uint64_t hash, Node* next);
+    static void destroyNode(Node* node);
+
+    // Move up to migrateBuckets_ non-empty buckets from the old table to the new one.
+    void migrate();
+
+    // Start growing once the load factor reaches one.
+    void maybeGrow();
+
+    // Find the link pointing at key's node, or at the null end of its chain.
+    Node** link(const KeyType& key, std::uint64_t hash) const;
+
+public:
+
+    incremental_hash_map() = default;
+    incremental_hash_map(const incremental_hash_map&) = delete;
+    incremental_hash_map& operator=(const incremental_hash_map&) = delete;
+    incremental_hash_map(incremental_hash_map&& other) noexcept;
+    incremental_hash_map& operator=(incremental_hash_map&& other) noexcept;
+    ~incremental_hash_map();
+
+    size_t size() const { return size_; } ///< Returns the number of keys in the map.
+
+    bool empty() const { return size_ == 0; } ///< Checks whether the map is empty.
+
+    bool rehashing() const { return tables_[1].buckets != nullptr; } ///< Checks whether a table migration is in progress.
+
+    size_t bucket_count() const { return rehashing() ? tables_[1].size() : tables_[0].size(); } ///< Returns the bucket count the map is growing into.
+
+    iterator end() { return nullptr; } ///< Returns the past-the-end iterator.
+
+    const_iterator end() const { return nullptr; } ///< Returns the past-the-end iterator.
+
+    iterator find(const KeyType& key); ///< Returns an iterator to the entry for key, or end() if absent.
+
+    const_iterator find(const KeyType& key) const; ///< Returns an iterator to the entry for key, or end() if absent.
+
+    size_t count(const KeyType& key) const { return find(key) != end(); } ///< Returns the count of a particular key in the map.
+
+    std::pair<iterator, bool> try_emplace(const KeyType& key); ///< Returns the entry for key and whether it was inserted, inserting a default mapped value if absent.
+
+    Mapped& operator[](const KeyType& key) { return try_emplace(key).first->second; } ///< Returns the mapped value of key, inserting a default one if absent.
+
+    Mapped& at(const KeyType& key); ///< Returns the mapped value of key. Throws std::out_of_range if absent.
+
+    size_t erase(const KeyType& key); ///< Erases key from the map. Returns the number of elements removed (0 or 1).
+};
+
+// Out-of-line implementation of incremental_hash_map methods
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename incremental_hash_map<KeyType, Mapped, Hash, Allocator>::Table incremental_hash_map<KeyType, Mapped, Hash, Allocator>::allocate(unsigned bits) {
+    Table table;
+    table.buckets = static_cast<Node**>(std::calloc(std::size_t(1) << bits, sizeof(Node*)));
+    if (!table.buckets) {
+        throw std::bad_alloc();
+    }
+    table.bits = bits;
+    return table;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+void incremental_hash_map<KeyType, Mapped, Hash, Allocator>::release(Table& table) {
+    std::free(table.buckets);
+    table = Table();
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename incremental_hash_map<KeyType, Mapped, Hash, Allocator>::Node* incremental_hash_map<KeyType, Mapped, Hash, Allocator>::createNode(const KeyType& key, std::uint64_t hash, Node* next) {
+    node_allocator alloc;
+    Node* node = node_traits::allocate(alloc, 1);
+    try {
+        ::new (static_cast<void*>(node)) Node{value_type(key, Mapped()), hash, next};
+    } catch (...) {
+        node_traits::deallocate(alloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+void incremental_hash_map<KeyType, Mapped, Hash, Allocator>::destroyNode(Node* node) {
+    node_allocator alloc;
+    node->~Node();
+    node_traits::deallocate(alloc, node, 1);
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+incremental_hash_map<KeyType, Mapped, Hash, Allocator>::incremental_hash_map(incremental_hash_map&& other) noexcept
+    : hash_(std::move(other.hash_)), migrated_(other.migrated_), size_(other.size_) {
+    tables_[0] = other.tables_[0];
+    tables_[1] = other.tables_[1];
+    other.tables_[0] = other.tables_[1] = Table();
+    other.migrated_ = other.size_ = 0;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+incremental_hash_map<KeyType, Mapped, Hash, Allocator>& incremental_hash_map<KeyType, Mapped, Hash, Allocator>::operator=(incremental_hash_map&& other) noexcept {
+    if (this != &other) {
+        // Take other's state, and let tmp free what this map held
+        incremental_hash_map tmp(std::move(other));
+        std::swap(hash_, tmp.hash_);
+        std::swap(tables_[0], tmp.tables_[0]);
+        std::swap(tables_[1], tmp.tables_[1]);
+        std::swap(migrated_, tmp.migrated_);
+        std::swap(size_, tmp.size_);
+    }
+    return *this;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+incremental_hash_map<KeyType, Mapped, Hash, Allocator>::~incremental_hash_map() {
+    for (auto& table : tables_) {
+        for (std::size_t b = 0; b < table.size(); b++) {
+            for (Node* node = table.buckets[b]; node;) {
+                Node* next = node->next;
+                destroyNode(node);
+                node = next;
+            }
+        }
+        release(table);
+    }
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+void incremental_hash_map<KeyType, Mapped, Hash, Allocator>::migrate() {
+    Table& from = tables_[0];
+    Table& to = tables_[1];
+
+    // Bound the empty buckets skipped as well, like Redis does
+    std::size_t moved = 0;
+    std::size_t visited = 0;
+    while (migrated_ < from.size() && moved < migrateBuckets_ && visited < 10 * migrateBuckets_) {
+        Node* node = from.buckets[migrated_];
+        from.buckets[migrated_++] = nullptr;
+        visited++;
+        if (!node) {
+            continue;
+        }
+        while (node) {
+            Node* next = node->next;
+            Node*& head = to.buckets[to.index(node->hash)];
+            node->next = head;
+            head = node;
+            node = next;
+        }
+        moved++;
+    }
+
+    if (migrated_ == from.size()) {
+        release(from);
+        from = to;
+        to = Table();
+        migrated_ = 0;
+    }
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+void incremental_hash_map<KeyType, Mapped, Hash, Allocator>::maybeGrow() {
+    if (!tables_[0].buckets) {
+        tables_[0] = allocate(minBits_);
+        return;
+    }
+    if (rehashing()) {
+        migrate();
+        return;
+    }
+    if (size_ >= tables_[0].size()) {
+        tables_[1] = allocate(tables_[0].bits + 1);
+        migrated_ = 0;
+        migrate();
+    }
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename incremental_hash_map<KeyType, Mapped, Hash, Allocator>::Node** incremental_hash_map<KeyType, Mapped, Hash, Allocator>::link(const KeyType& key, std::uint64_t hash) const {
+    // Buckets of the old table below migrated_ are already empty, so probing them is harmless
+    Node** last = nullptr;
+    for (const auto& table : tables_) {
+        if (!table.buckets) {
+            continue;
+        }
+        Node** cur = &table.buckets[table.index(hash)];
+        while (*cur) {
+            if ((*cur)->hash == hash && (*cur)->value.first == key) {
+                return cur;
+            }
+            cur = &(*cur)->next;
+        }
+        last = cur;
+    }
+    return last;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename incremental_hash_map<KeyType, Mapped, Hash, Allocator>::iterator incremental_hash_map<KeyType, Mapped, Hash, Allocator>::find(const KeyType& key) {
+    if (rehashing()) {
+        migrate();
+    }
+    if (size_ == 0) {
+        return nullptr;
+    }
+    Node** cur = link(key, hashKey(key));
+    return *cur ? &(*cur)->value : nullptr;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename incremental_hash_map<KeyType, Mapped, Hash, Allocator>::const_iterator incremental_hash_map<KeyType, Mapped, Hash, Allocator>::find(const KeyType& key) const {
+    if (size_ == 0) {
+        return nullptr;
+    }
+    Node** cur = link(key, hashKey(key));
+    return *cur ? &(*cur)->value : nullptr;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+std::pair<typename incremental_hash_map<KeyType, Mapped, Hash, Allocator>::iterator, bool> incremental_hash_map<KeyType, Mapped, Hash, Allocator>::try_emplace(const KeyType& key) {
+    maybeGrow();
+
+    const std::uint64_t hash = hashKey(key);
+    Node** cur = link(key, hash);
+    if (*cur) {
+        return {&(*cur)->value, false};
+    }
+
+    // New keys always go to the newest table, never to a bucket already migrated
+    Table& table = rehashing() ? tables_[1] : tables_[0];
+    Node*& head = table.buckets[table.index(hash)];
+    head = createNode(key, hash, head);
+    size_++;
+    return {&head->value, true};
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+Mapped& incremental_hash_map<KeyType, Mapped, Hash, Allocator>::at(const KeyType& key) {
+    auto it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("Key not found in incremental_hash_map.");
+    }
+    return it->second;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+size_t incremental_hash_map<KeyType, Mapped, Hash, Allocator>::erase(const KeyType& key) {
+    if (rehashing()) {
+        migrate();
+    }
+    if (size_ == 0) {
+        return 0;
+    }
+    Node** cur = link(key, hashKey(key));
+    if (!*cur) {
+        return 0;
+    }
+    Node* node = *cur;
+    *cur = node->next;
+    destroyNode(node);
+    size_--;
+    return 1;
+}
+
+} // namespace
+
+#endif // WILDERFIELD_INCREMENTAL_HASH_MAP_HPP
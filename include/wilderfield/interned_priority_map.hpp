@@ -0,0 +1,119 @@
+/**
+ * @file interned_priority_map.hpp
+ * @brief Interned Priority Map Template Class Definition
+ *
+ * Defines a priority map over string keys that interns each key once and keeps
+ * only its 32-bit id in the key index.
+ */
+
+#ifndef WILDERFIELD_INTERNED_PRIORITY_MAP_HPP
+#define WILDERFIELD_INTERNED_PRIORITY_MAP_HPP
+
+#include "wilderfield/priority_map.hpp"
+#include "wilderfield/string_interner.hpp"
+
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace wilderfield {
+
+/**
+ * @brief Interned priority map class
+ *
+ * Wraps a priority_map keyed by string_interner ids. Every distinct key string is
+ * stored once in the interner's arena, and all lookups take a std::string_view.
+ * The interner is append-only, so erased keys keep their bytes and get their old
+ * id back if they are inserted again.
+ *
+ * @tparam ValType The type of the values (priorities), must be numeric.
+ * @tparam Compare Comparison class used to maintain the ordering of values.
+ */
+template<
+    typename ValType,
+    typename Compare = std::greater<ValType>
+>
+class interned_priority_map final {
+
+public:
+    using id_type = string_interner::id_type;                  ///< Type of the interned key ids.
+    using id_map_type = priority_map<id_type, ValType, Compare>; ///< Priority map over the ids.
+    using Proxy = typename id_map_type::Proxy;                  ///< Proxy returned by operator[].
+
+private:
+    string_interner interner_; ///< Arena holding each key string once.
+    id_map_type pmap_;         ///< Priority map keyed by interned ids.
+
+public:
+
+    size_t size() const { return pmap_.size(); } ///< Returns the number of unique keys in the priority map.
+
+    bool empty() const { return pmap_.empty(); } ///< Checks whether the priority map is empty.
+
+    size_t count(std::string_view key) const { return contains(key); } ///< Returns the count of a particular key in the map.
+
+    bool contains(std::string_view key) const; ///< Checks whether key is in the priority map. Never inserts.
+
+    std::optional<ValType> get(std::string_view key) const; ///< Returns the value of key, or std::nullopt if key is absent. Never inserts.
+
+    std::pair<std::string_view, ValType> top() const; ///< Returns the top element (key-value pair) in the priority map.
+
+    size_t erase(std::string_view key); ///< Erases key from the priority map. Returns the number of elements removed (0 or 1).
+
+    void pop() { pmap_.pop(); } ///< Removes the top element from the priority map.
+
+    Proxy operator[](std::string_view key) { return pmap_[interner_.intern(key)]; } ///< Returns a proxy for key, inserting it at 0 if absent.
+
+    const string_interner& interner() const { return interner_; } ///< Returns the interner holding the key strings.
+
+    const id_map_type& ids() const { return pmap_; } ///< Returns the underlying priority map keyed by ids.
+};
+
+// Out-of-line implementation of interned_priority_map methods
+
+template<
+    typename ValType,
+    typename Compare
+>
+bool interned_priority_map<ValType, Compare>::contains(std::string_view key) const {
+    auto id = interner_.find(key);
+    return id && pmap_.contains(*id);
+}
+
+template<
+    typename ValType,
+    typename Compare
+>
+std::optional<ValType> interned_priority_map<ValType, Compare>::get(std::string_view key) const {
+    auto id = interner_.find(key);
+    if (!id) {
+        return std::nullopt;
+    }
+    return pmap_.get(*id);
+}
+
+template<
+    typename ValType,
+    typename Compare
+>
+std::pair<std::string_view, ValType> interned_priority_map<ValType, Compare>::top() const {
+    auto [id, val] = pmap_.top();
+    return {interner_[id], val};
+}
+
+template<
+    typename ValType,
+    typename Compare
+>
+size_t interned_priority_map<ValType, Compare>::erase(std::string_view key) {
+    auto id = interner_.find(key);
+    if (!id) {
+        return 0;
+    }
+    return pmap_.erase(*id);
+}
+
+} // namespace
+
+#endif // WILDERFIELD_INTERNED_PRIORITY_MAP_HPP
@@ -0,0 +1,197 @@
+/**
+ * @file minimal_perfect_hash.hpp
+ * @brief Minimal Perfect Hash Template Class Definition
+ *
+ * Defines a minimal perfect hash function over a key set known at construction
+ * time, built with the CHD (compress, hash, displace) method.
+ */
+
+#ifndef WILDERFIELD_MINIMAL_PERFECT_HASH_HPP
+#define WILDERFIELD_MINIMAL_PERFECT_HASH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace wilderfield {
+
+/**
+ * @brief Minimal perfect hash class
+ *
+ * Maps each of n distinct keys to its own index in [0, n) by hashing the key
+ * into one of about n/2 groups and applying that group's displacement. Only the
+ * displacements are stored, about two bytes per key, and not the keys, so a
+ * key outside the set also gets some index in range. Callers that must reject
+ * such keys compare against the key they keep at that index.
+ *
+ * The seed is mixed into the result of Hash, so no seed can separate distinct
+ * keys that Hash maps to the same value. Such a key set is rejected rather than
+ * searched for forever.
+ *
+ * @tparam KeyType The type of the keys.
+ * @tparam Hash Hashing class used for keys.
+ */
+template<
+    typename KeyType,
+    typename Hash = std::hash<KeyType>
+>
+class minimal_perfect_hash final {
+
+private:
+    static constexpr std::uint32_t groupLoad_ = 2;               ///< Average number of keys per displacement group.
+    static constexpr std::uint32_t minDisplacements_ = 1u << 16; ///< Displacements tried per group before reseeding, at least.
+
+    Hash hash_;
+    std::uint64_t seed_ = 0;          ///< Seed mixed into every hash, changed on failed builds.
+    std::vector<std::uint32_t> disp_; ///< Displacement of each group.
+    std::size_t size_ = 0;            ///< Number of keys, and of indices.
+
+    // Stafford's mix13 finalizer, spreading all bits of h.
+    static std::uint64_t mix(std::uint64_t h) {
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    std::uint64_t hashKey(const KeyType& key) const { return mix(static_cast<std::uint64_t>(hash_(key)) ^ seed_); }
+
+    std::size_t group(std::uint64_t h) const { return static_cast<std::size_t>(h % disp_.size()); }
+
+    static std::size_t slot(std::uint64_t h, std::uint32_t d, std::size_t n) {
+        return static_cast<std::size_t>(mix(h + d * 0x9e3779b97f4a7c15ULL) % n);
+    }
+
+    // Try to place all keys with the current seed. Throws std::invalid_argument on a duplicate key or a Hash collision.
+    bool place(const std::vector<KeyType>& keys);
+
+public:
+
+    minimal_perfect_hash() = default;
+
+    template<typename InputIt>
+    minimal_perfect_hash(InputIt first, InputIt last, const Hash& hash = Hash()); ///< Builds the hash over the keys in [first, last). Throws std::invalid_argument on a duplicate key or on distinct keys of equal Hash value.
+
+    std::size_t size() const { return size_; } ///< Returns the number of keys, which is also the number of indices.
+
+    std::size_t operator()(const KeyType& key) const; ///< Returns the index of key, below size() for any key. Distinct for the keys built over. Requires size() > 0.
+
+    std::size_t memory_bytes() const { return disp_.capacity() * sizeof(std::uint32_t); } ///< Returns the heap memory used.
+};
+
+// Out-of-line implementation of minimal_perfect_hash methods
+
+template<
+    typename KeyType,
+    typename Hash
+>
+template<typename InputIt>
+minimal_perfect_hash<KeyType, Hash>::minimal_perfect_hash(InputIt first, InputIt last, const Hash& hash) : hash_(hash) {
+    const std::vector<KeyType> keys(first, last);
+    size_ = keys.size();
+    if (keys.empty()) {
+        return;
+    }
+
+    disp_.assign((keys.size() + groupLoad_ - 1) / groupLoad_, 0);
+    while (!place(keys)) {
+        seed_ = mix(seed_ + 1);
+    }
+    disp_.shrink_to_fit();
+}
+
+template<
+    typename KeyType,
+    typename Hash
+>
+bool minimal_perfect_hash<KeyType, Hash>::place(const std::vector<KeyType>& keys) {
+
+    const std::size_t n = keys.size();
+
+    std::vector<std::uint64_t> hashes(n);
+    std::vector<std::vector<std::size_t>> groups(disp_.size());
+    for (std::size_t i = 0; i < n; i++) {
+        hashes[i] = hashKey(keys[i]);
+        groups[group(hashes[i])].push_back(i);
+    }
+
+    // Keys of equal hash can never part. Equal keys or equal Hash values stay
+    // equal under every seed and are errors, anything else is a bad seed.
+    for (const auto& members : groups) {
+        for (std::size_t a = 0; a < members.size(); a++) {
+            for (std::size_t b = a + 1; b < members.size(); b++) {
+                const KeyType& keyA = keys[members[a]];
+                const KeyType& keyB = keys[members[b]];
+                if (hashes[members[a]] == hashes[members[b]]) {
+                    if (keyA == keyB) {
+                        throw std::invalid_argument("Duplicate key in minimal_perfect_hash.");
+                    }
+                    if (hash_(keyA) == hash_(keyB)) {
+                        throw std::invalid_argument("Keys of equal hash in minimal_perfect_hash.");
+                    }
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Place the largest groups first, while most slots are still free
+    std::vector<std::size_t> order(groups.size());
+    for (std::size_t g = 0; g < order.size(); g++) {
+        order[g] = g;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return groups[a].size() > groups[b].size();
+    });
+
+    std::vector<bool> used(n, false);
+    std::vector<std::size_t> taken;
+
+    // The last singleton groups need about n tries to hit the few free slots left
+    const std::uint32_t limit = static_cast<std::uint32_t>(std::min<std::uint64_t>(
+        std::max<std::uint64_t>(minDisplacements_, 16 * std::uint64_t(n)), UINT32_MAX));
+
+    for (auto g : order) {
+        if (groups[g].empty()) {
+            break;
+        }
+        bool placed = false;
+        for (std::uint32_t d = 0; d < limit && !placed; d++) {
+            taken.clear();
+            placed = true;
+            for (auto i : groups[g]) {
+                const std::size_t s = slot(hashes[i], d, n);
+                if (used[s] || std::find(taken.begin(), taken.end(), s) != taken.end()) {
+                    placed = false;
+                    break;
+                }
+                taken.push_back(s);
+            }
+            if (placed) {
+                for (auto s : taken) {
+                    used[s] = true;
+                }
+                disp_[g] = d;
+            }
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<
+    typename KeyType,
+    typename Hash
+>
+std::size_t minimal_perfect_hash<KeyType, Hash>::operator()(const KeyType& key) const {
+    const std::uint64_t h = hashKey(key);
+    return slot(h, disp_[group(h)], size_);
+}
+
+} // namespace
+
+#endif // WILDERFIELD_MINIMAL_PERFECT_HASH_HPP
@@ -0,0 +1,257 @@
+/**
+ * @file perfect_hash_map.hpp
+ * @brief Perfect Hash Map Template Class Definition
+ *
+ * Defines a map over a key set known at construction time. The known keys are
+ * placed by a minimal perfect hash built with the CHD (compress, hash, displace)
+ * method, and keys outside that set go to a small fallback table.
+ */
+
+#ifndef WILDERFIELD_PERFECT_HASH_MAP_HPP
+#define WILDERFIELD_PERFECT_HASH_MAP_HPP
+
+#include "wilderfield/minimal_perfect_hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+
+/**
+ * @brief Perfect hash map class
+ *
+ * Every key of the static key set owns exactly one of n slots, found by hashing
+ * the key into one of about n/2 groups and applying that group's displacement.
+ * A lookup is therefore two multiply-xorshift mixes and one array access, with
+ * no probing. Slots hold the key once, which is what lets a lookup reject keys
+ * outside the static set; those keys live in a std::unordered_map fallback,
+ * as do keys whose Hash value equals that of an earlier key of the set.
+ * Entries never move, so iterators stay valid until their entry is erased.
+ *
+ * Satisfies the key index requirements of priority_map.
+ *
+ * @tparam KeyType The type of the keys.
+ * @tparam Mapped The type of the mapped values, must be default constructible.
+ * @tparam Hash Hashing class used for keys.
+ * @tparam Allocator Allocator for the entries, rebound as needed.
+ */
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash = std::hash<KeyType>,
+    typename Allocator = std::allocator<std::pair<const KeyType, Mapped>>
+>
+class perfect_hash_map final {
+
+public:
+    using value_type = std::pair<const KeyType, Mapped>; ///< Type of the entries.
+    using iterator = value_type*;                        ///< Iterator to an entry, nullptr is end().
+    using const_iterator = const value_type*;            ///< Const iterator to an entry, nullptr is end().
+
+private:
+    using entry_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<value_type>;
+
+    minimal_perfect_hash<KeyType, Hash> index_; ///< Slot of each static key.
+    std::vector<value_type, entry_allocator> slots_; ///< One entry per static key, at its perfect hash slot.
+    std::vector<bool> present_;          ///< Whether each static key is currently in the map.
+    std::size_t present_count_ = 0;      ///< Number of static keys currently in the map.
+
+    std::unordered_map<KeyType, Mapped, Hash, std::equal_to<KeyType>, entry_allocator> fallback_; ///< Keys outside the static set.
+
+    // Slot of key if it belongs to the static key set, or slots_.size() otherwise.
+    std::size_t staticSlot(const KeyType& key) const;
+
+public:
+
+    perfect_hash_map() = default;
+
+    template<typename InputIt>
+    perfect_hash_map(InputIt first, InputIt last, const Hash& hash = Hash()); ///< Builds the perfect hash over the keys in [first, last). The map starts empty.
+
+    size_t size() const { return present_count_ + fallback_.size(); } ///< Returns the number of keys in the map.
+
+    bool empty() const { return size() == 0; } ///< Checks whether the map is empty.
+
+    size_t static_size() const { return slots_.size(); } ///< Returns the number of keys in the static key set.
+
+    size_t fallback_size() const { return fallback_.size(); } ///< Returns the number of keys held in the fallback table.
+
+    size_t memory_bytes() const; ///< Returns an estimate of the heap memory used, counting fallback nodes as an entry and a pointer.
+
+    iterator end() { return nullptr; } ///< Returns the past-the-end iterator.
+
+    const_iterator end() const { return nullptr; } ///< Returns the past-the-end iterator.
+
+    iterator find(const KeyType& key); ///< Returns an iterator to the entry for key, or end() if absent.
+
+    const_iterator find(const KeyType& key) const; ///< Returns an iterator to the entry for key, or end() if absent.
+
+    size_t count(const KeyType& key) const { return find(key) != end(); } ///< Returns the count of a particular key in the map.
+
+    std::pair<iterator, bool> try_emplace(const KeyType& key); ///< Returns the entry for key and whether it was inserted, inserting a default mapped value if absent.
+
+    Mapped& operator[](const KeyType& key) { return try_emplace(key).first->second; } ///< Returns the mapped value of key, inserting a default one if absent.
+
+    Mapped& at(const KeyType& key); ///< Returns the mapped value of key. Throws std::out_of_range if absent.
+
+    size_t erase(const KeyType& key); ///< Erases key from the map. Returns the number of elements removed (0 or 1).
+};
+
+// Out-of-line implementation of perfect_hash_map methods
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+template<typename InputIt>
+perfect_hash_map<KeyType, Mapped, Hash, Allocator>::perfect_hash_map(InputIt first, InputIt last, const Hash& hash) : fallback_(0, hash) {
+
+    // Drop duplicates, they would never fit in distinct slots. Of keys with equal
+    // Hash values only the first gets a slot, the rest go to the fallback when inserted.
+    std::vector<KeyType> keys;
+    std::unordered_set<KeyType, Hash> seen(0, hash);
+    std::unordered_set<std::size_t> hashes;
+    for (; first != last; ++first) {
+        if (seen.insert(*first).second && hashes.insert(static_cast<std::size_t>(hash(*first))).second) {
+            keys.push_back(*first);
+        }
+    }
+    if (keys.empty()) {
+        return;
+    }
+
+    index_ = minimal_perfect_hash<KeyType, Hash>(keys.begin(), keys.end(), hash);
+    std::vector<std::size_t> owner(keys.size());
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        owner[index_(keys[i])] = i;
+    }
+
+    slots_.reserve(keys.size());
+    for (std::size_t s = 0; s < owner.size(); s++) {
+        slots_.emplace_back(keys[owner[s]], Mapped());
+    }
+    present_.assign(slots_.size(), false);
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+std::size_t perfect_hash_map<KeyType, Mapped, Hash, Allocator>::staticSlot(const KeyType& key) const {
+    if (slots_.empty()) {
+        return 0;
+    }
+    const std::size_t s = index_(key);
+    return slots_[s].first == key ? s : slots_.size();
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+size_t perfect_hash_map<KeyType, Mapped, Hash, Allocator>::memory_bytes() const {
+    return index_.memory_bytes()
+        + slots_.capacity() * sizeof(value_type)
+        + (present_.size() + 7) / 8
+        + fallback_.size() * (sizeof(value_type) + sizeof(void*))
+        + fallback_.bucket_count() * sizeof(void*);
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename perfect_hash_map<KeyType, Mapped, Hash, Allocator>::iterator perfect_hash_map<KeyType, Mapped, Hash, Allocator>::find(const KeyType& key) {
+    const std::size_t s = staticSlot(key);
+    if (s != slots_.size()) {
+        return present_[s] ? &slots_[s] : nullptr;
+    }
+    if (fallback_.empty()) {
+        return nullptr;
+    }
+    auto it = fallback_.find(key);
+    return it == fallback_.end() ? nullptr : &*it;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+typename perfect_hash_map<KeyType, Mapped, Hash, Allocator>::const_iterator perfect_hash_map<KeyType, Mapped, Hash, Allocator>::find(const KeyType& key) const {
+    return const_cast<perfect_hash_map*>(this)->find(key);
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+std::pair<typename perfect_hash_map<KeyType, Mapped, Hash, Allocator>::iterator, bool> perfect_hash_map<KeyType, Mapped, Hash, Allocator>::try_emplace(const KeyType& key) {
+    const std::size_t s = staticSlot(key);
+    if (s != slots_.size()) {
+        if (present_[s]) {
+            return {&slots_[s], false};
+        }
+        slots_[s].second = Mapped();
+        present_[s] = true;
+        present_count_++;
+        return {&slots_[s], true};
+    }
+    auto [it, inserted] = fallback_.try_emplace(key);
+    return {&*it, inserted};
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+Mapped& perfect_hash_map<KeyType, Mapped, Hash, Allocator>::at(const KeyType& key) {
+    auto it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("Key not found in perfect_hash_map.");
+    }
+    return it->second;
+}
+
+template<
+    typename KeyType,
+    typename Mapped,
+    typename Hash,
+    typename Allocator
+>
+size_t perfect_hash_map<KeyType, Mapped, Hash, Allocator>::erase(const KeyType& key) {
+    const std::size_t s = staticSlot(key);
+    if (s != slots_.size()) {
+        if (!present_[s]) {
+            return 0;
+        }
+        present_[s] = false;
+        present_count_--;
+        return 1;
+    }
+    return fallback_.erase(key);
+}
+
+} // namespace
+
+#endif // WILDERFIELD_PERFECT_HASH_MAP_HPP
@@ -11,14 +11,34 @@
 
 #include <unordered_map>
 #include <list>
-#include <unordered_set>
+#include <map>
 #include <iterator>
 #include <functional>
 #include <type_traits>
 #include <algorithm>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace wilderfield {
 
+/**
+ * @brief Default key index of priority_map
+ *
+ * Any class template with this signature can serve as a priority_map key index,
+ * as long as it provides find(), end(), operator[], try_emplace(key), erase(key), size()
+ * and empty() with the semantics of std::unordered_map, holds std::pair<const KeyType, Mapped>
+ * entries that stay at the same address until they are erased, and lets erase(key)
+ * take a reference to the key of the entry it erases. The allocator is passed
+ * unbound and should be rebound to whatever the index allocates.
+ */
+template<typename KeyType, typename Mapped, typename Hash, typename Allocator>
+using unordered_key_index = std::unordered_map<KeyType, Mapped, Hash, std::equal_to<KeyType>,
+    typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const KeyType, Mapped>>>;
+
 /**
  * @brief Priority map class
  *
@@ -26,49 +46,156 @@ namespace wilderfield {
  * The map maintains the keys in sorted order based on their priority, allowing
  * for efficient retrieval and modification of priorities.
  *
+ * Distinct values form a sorted list, and the keys sharing a value are linked
+ * into that value's bucket through their key index entries. Moving a key to
+ * another value therefore costs one key lookup and no hashing of values, and
+ * only the key index ever rehashes.
+ *
  * @tparam KeyType The type of the keys.
  * @tparam ValType The type of the values (priorities), must be numeric.
  * @tparam Compare Comparison class used to maintain the ordering of values.
  * @tparam Hash Hashing class used for keys.
+ * @tparam KeyIndex Map template used to index keys, see unordered_key_index.
+ * @tparam Allocator Default constructible allocator used for all nodes, rebound as needed.
  */
 template<
     typename KeyType,
     typename ValType,
     typename Compare = std::greater<ValType>,
-    typename Hash = std::hash<KeyType>
+    typename Hash = std::hash<KeyType>,
+    template<typename, typename, typename, typename> class KeyIndex = unordered_key_index,
+    typename Allocator = std::allocator<KeyType>
 >
 class priority_map final {
 
 static_assert(std::is_arithmetic<ValType>::value, "ValType must be a numeric type.");
 
+    template<typename T>
+    using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    struct Slot;
+    using entry_type = std::pair<const KeyType, Slot>;
+
+    // One distinct value and its bucket, the keys holding it, as an intrusive
+    // list through their key index entries, so buckets never hash or rehash
+    struct ValNode {
+        ValType val;
+        entry_type* head = nullptr;
+    };
+
+    using list_type = std::list<ValNode, rebind_alloc<ValNode>>;
+
+    // What the key index holds per key: its value node and its bucket neighbours
+    struct Slot {
+        typename list_type::iterator node;
+        entry_type* prev = nullptr;
+        entry_type* next = nullptr;
+    };
+
+public:
+    using key_index_type = KeyIndex<KeyType, Slot, Hash, Allocator>; ///< Type of the map from keys to their values.
+
 private:
+    static_assert(std::is_same<typename key_index_type::value_type, entry_type>::value,
+                  "The key index must hold std::pair<const KeyType, Mapped> entries.");
+
     Compare comp_;
 
-    std::list<ValType> vals_; ///< List to maintain sorted values.
+    list_type vals_; ///< List to maintain sorted values, each with the bucket of its keys.
 
-    std::unordered_map<KeyType, typename std::list<ValType>::iterator, Hash> keys_; ///< Map from keys to their corresponding list iterator in vals_.
+    key_index_type keys_; ///< Map from keys to their value node in vals_ and their bucket links.
 
-    std::unordered_map<ValType, std::unordered_set<KeyType>> valToKeys_; ///< Map from vals to their corresponding keys
+    std::map<ValType, typename list_type::iterator, Compare,
+        rebind_alloc<std::pair<const ValType, typename list_type::iterator>>> valIndex_; ///< Ordered map from vals to their node in vals_, built on the first far move
+
+    bool valIndexed_ = false; ///< Whether valIndex_ is built and kept in step with vals_.
+
+    size_t nearInserts_ = 0; ///< Nodes inserted by a short walk since the last far move.
 
     // Private member functions
 
     // Insert new key
     void insert(const KeyType& key, const ValType& newVal);
 
+    // Insert key, which must be absent, at val.
+    void insertNew(const KeyType& key, const ValType& val);
+
+    // Push entry onto the bucket of node.
+    static void link(entry_type* entry, typename list_type::iterator node);
+
+    // Take entry out of its bucket, leaving its node in vals_ even if the bucket empties.
+    static void unlink(entry_type* entry);
+
+    // Copy other's values, buckets and bucket order into this map, whose keys_ already holds other's keys.
+    void relink(const priority_map& other);
+
     // Update Key with Val
     // This function can be used for increment, decrement, or assigning a new val
     void update(const KeyType& key, const ValType& newVal);
 
     // Get the value associated with a key.
-    ValType getVal(const KeyType& key) const { return *(keys_.at(key)); }
+    ValType getVal(const KeyType& key) const { return at(key); }
+
+    // Steps walked from a hint in vals_ before falling back to valIndex_.
+    static constexpr size_t shortWalk_ = 4;
+
+    // Node of val in vals_, inserted if missing. Values near hint, as after ++ or --, are found by walking from it.
+    typename list_type::iterator findOrInsertVal(const ValType& val, typename list_type::iterator hint);
+
+    // Remove node it from vals_ and valIndex_.
+    void eraseVal(typename list_type::iterator it);
+
+    // Index every node of vals_ in valIndex_.
+    void buildValIndex();
+
+    // Keys summed per block by increment_many.
+    static constexpr size_t batchBlock_ = 256;
+
+    // Smallest share of a bulk load worth handing to a thread of its own.
+    static constexpr size_t minBulkItemsPerThread_ = size_t(1) << 14;
+
+    // Sort (key, value) pairs so that top values come first, using up to threads threads.
+    void sortByPriority(std::vector<std::pair<KeyType, ValType>>& items, size_t threads) const;
+
+    // True when bulk loads can group values with a radix sort instead of comparisons.
+    static constexpr bool radixValues_ = std::is_integral<ValType>::value && !std::is_same<ValType, bool>::value;
+
+    // Bits of the radix sort digits, so a pass's histograms fit in L1.
+    static constexpr unsigned radixBits_ = 11;
+
+    // Stable LSD radix sort of integral values, the same order as sortByPriority.
+    void radixSortByPriority(std::vector<std::pair<KeyType, ValType>>& items, size_t threads) const;
+
+    // Build the value list, buckets and key index from pairs sorted by sortByPriority.
+    void buildSorted(const std::vector<std::pair<KeyType, ValType>>& items);
+
+    // True when hashing and comparing keys cannot throw, so lookups cannot either.
+    static constexpr bool nothrow_lookup_ =
+        noexcept(std::declval<const Hash&>()(std::declval<const KeyType&>())) &&
+        noexcept(std::declval<const KeyType&>() == std::declval<const KeyType&>());
 
 public:
 
+    priority_map() = default;
+
+    explicit priority_map(key_index_type keys) : keys_(std::move(keys)) {} ///< Constructs an empty priority map using a prepared key index, which must be empty.
+
+    priority_map(const priority_map& other); ///< Copies other, keeping its bucket order. Needs a copyable key index.
+
+    priority_map(priority_map&&) = default;
+
+    priority_map& operator=(const priority_map& other); ///< Replaces the contents with a copy of other.
+
+    priority_map& operator=(priority_map&&) = default;
+
+    template<typename InputIt>
+    priority_map(InputIt first, InputIt last, size_t threads = 0); ///< Bulk loads the (key, value) pairs in [first, last) sorting on up to threads threads, all hardware threads when 0. Throws std::invalid_argument on duplicate keys.
+
     size_t size() const { return keys_.size(); } ///< Returns the number of unique keys in the priority map.
 
     bool empty() const { return keys_.empty(); } ///< Checks whether the priority map is empty.
 
-    size_t count(const KeyType& key) const { return keys_.count(key); } ///< Returns the count of a particular key in the map.
+    size_t count(const KeyType& key) const { return keys_.find(key) != keys_.end(); } ///< Returns the count of a particular key in the map.
 
     std::pair<KeyType, ValType> top() const; ///< Returns the top element (key-value pair) in the priority map.
 
@@ -76,6 +203,32 @@ public:
 
     void pop(); ///< Removes the top element from the priority map.
 
+    std::optional<std::pair<KeyType, ValType>> try_top() const noexcept(nothrow_lookup_ && std::is_nothrow_copy_constructible<KeyType>::value); ///< Returns the top element, or std::nullopt if the priority map is empty.
+
+    bool try_pop() noexcept(nothrow_lookup_); ///< Removes the top element if there is one. Returns whether an element was removed.
+
+    template<typename OutputIt>
+    OutputIt pop_top_bucket(OutputIt out); ///< Removes every element sharing the top value, writing their keys to out in no particular order. Returns the end of the output.
+
+    std::vector<std::pair<KeyType, ValType>> top_k(size_t k) const; ///< Returns up to k elements with the highest priority, in priority order. Ties are in no particular order.
+
+    const ValType* find(const KeyType& key) const noexcept(nothrow_lookup_); ///< Returns a pointer to the value of key, or nullptr if key is absent. Never inserts.
+
+    ValType value_or(const KeyType& key, const ValType& dflt) const noexcept(nothrow_lookup_); ///< Returns the value of key, or dflt if key is absent. Never inserts.
+
+    ValType at(const KeyType& key) const; ///< Returns the value of key. Throws std::out_of_range if key is absent.
+
+    std::optional<ValType> get(const KeyType& key) const noexcept(nothrow_lookup_); ///< Returns the value of key, or std::nullopt if key is absent. Never inserts.
+
+    bool contains(const KeyType& key) const noexcept(nothrow_lookup_) { return find(key) != nullptr; } ///< Checks whether key is in the priority map. Never inserts.
+
+    void assign(const KeyType& key, const ValType& val) { insert(key, val); } ///< Sets the value of key, inserting key straight at val if absent.
+
+    const key_index_type& key_index() const { return keys_; } ///< Returns the key index, e.g. to read its statistics.
+
+    template<typename InputIt>
+    void increment_many(InputIt first, InputIt last, const ValType& delta = 1); ///< Adds delta to the value of every key in [first, last), once per occurrence, inserting absent keys at 0.
+
     class Proxy;
     Proxy operator[](const KeyType& key);
 
@@ -110,6 +263,16 @@ public:
             --(*this);
             return temp;
         }
+
+        Proxy& operator+=(const ValType& delta) {
+            pm->update(key, pm->getVal(key)+delta);
+            return *this;
+        }
+
+        Proxy& operator-=(const ValType& delta) {
+            pm->update(key, pm->getVal(key)-delta);
+            return *this;
+        }
        	
         void operator=(const ValType& val) {pm->update(key, val);}
 
@@ -124,16 +287,19 @@ template<
     typename KeyType,
     typename ValType,
     typename Compare,
-    typename Hash
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
 >
-size_t priority_map<KeyType, ValType, Compare, Hash>::erase(const KeyType& key) {
-    if (keys_.find(key) != keys_.end()) {
-        auto oldIt = keys_[key];
-        valToKeys_[*oldIt].erase(key);
-        if (valToKeys_[*oldIt].empty()) {
-            valToKeys_.erase(*oldIt); // For now avoid memory bloat
-            vals_.erase(oldIt);
-        }
+size_t priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::erase(const KeyType& key) {
+    auto it = keys_.find(key);
+    if (it == keys_.end()) {
+        return 0;
+    }
+    auto node = it->second.node;
+    unlink(&*it);
+    if (node->head == nullptr) {
+        eraseVal(node);
     }
     return keys_.erase(key);
 }
@@ -142,93 +308,437 @@ template<
     typename KeyType,
     typename ValType,
     typename Compare,
-    typename Hash
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::priority_map(const priority_map& other) : comp_(other.comp_), keys_(other.keys_) {
+    relink(other);
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>& priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::operator=(const priority_map& other) {
+    if (this != &other) {
+        *this = priority_map(other);
+    }
+    return *this;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
 >
-std::pair<KeyType, ValType> priority_map<KeyType, ValType, Compare, Hash>::top() const {
+template<typename InputIt>
+priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::priority_map(InputIt first, InputIt last, size_t threads) {
+    std::vector<std::pair<KeyType, ValType>> items(first, last);
+    if (items.empty()) {
+        return;
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::max<size_t>(1, std::min(threads, items.size() / minBulkItemsPerThread_));
+
+    if constexpr (radixValues_) {
+        radixSortByPriority(items, threads);
+    }
+    else {
+        sortByPriority(items, threads);
+    }
+    buildSorted(items);
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::sortByPriority(std::vector<std::pair<KeyType, ValType>>& items, size_t threads) const {
+    auto byPriority = [this](const std::pair<KeyType, ValType>& a, const std::pair<KeyType, ValType>& b) {
+        return comp_(a.second, b.second);
+    };
+
+    std::vector<size_t> bounds(threads + 1);
+    for (size_t t = 0; t <= threads; t++) {
+        bounds[t] = items.size() * t / threads;
+    }
+    auto slice = [&](size_t t) { return items.begin() + bounds[std::min(t, threads)]; };
+
+    // Sort one slice per thread, then merge neighbouring slices pairwise in parallel rounds
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; t++) {
+        workers.emplace_back([&, t] { std::sort(slice(t), slice(t + 1), byPriority); });
+    }
+    std::sort(slice(0), slice(1), byPriority);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (size_t width = 1; width < threads; width *= 2) {
+        workers.clear();
+        for (size_t t = 2 * width; t + width < threads; t += 2 * width) {
+            workers.emplace_back([&, t] { std::inplace_merge(slice(t), slice(t + width), slice(t + 2 * width), byPriority); });
+        }
+        std::inplace_merge(slice(0), slice(width), slice(2 * width), byPriority);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::radixSortByPriority(std::vector<std::pair<KeyType, ValType>>& items, size_t threads) const {
+    using Radix = std::make_unsigned_t<ValType>;
+    constexpr unsigned valueBits = sizeof(Radix) * 8;
+    constexpr size_t digits = size_t(1) << radixBits_;
+
+    struct Entry {
+        Radix radix;
+        size_t index;
+    };
+
+    // Map values to unsigned radixes that sort ascending in priority order:
+    // flip the sign bit of signed values, and invert everything for max heaps
+    const Radix signFlip = std::is_signed<ValType>::value ? Radix(Radix(1) << (valueBits - 1)) : Radix(0);
+    const Radix orderFlip = comp_(1, 0) ? Radix(~Radix(0)) : Radix(0);
+
+    const size_t n = items.size();
+    std::vector<Entry> entries(n);
+    std::vector<Entry> scratch(n);
+    Radix varying = 0;
+    for (size_t i = 0; i < n; i++) {
+        entries[i] = {Radix(Radix(items[i].second) ^ signFlip ^ orderFlip), i};
+        varying |= Radix(entries[i].radix ^ entries[0].radix);
+    }
+
+    // Only the bits that differ between values need passes, often just one for counters
+    unsigned passes = 0;
+    while (passes * radixBits_ < valueBits && (varying >> (passes * radixBits_)) != 0) {
+        passes++;
+    }
+
+    std::vector<size_t> bounds(threads + 1);
+    for (size_t t = 0; t <= threads; t++) {
+        bounds[t] = n * t / threads;
+    }
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(digits));
+
+    auto runThreads = [&](auto&& task) {
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < threads; t++) {
+            workers.emplace_back(task, t);
+        }
+        task(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    for (unsigned pass = 0; pass < passes; pass++) {
+        const unsigned shift = pass * radixBits_;
+
+        // Per slice histograms, computed in parallel
+        runThreads([&](size_t t) {
+            auto& count = counts[t];
+            std::fill(count.begin(), count.end(), 0);
+            for (size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+                count[(entries[i].radix >> shift) & (digits - 1)]++;
+            }
+        });
+
+        // Turn the histograms into each slice's first output position per digit,
+        // slices in order within a digit so the sort stays stable
+        size_t offset = 0;
+        for (size_t d = 0; d < digits; d++) {
+            for (size_t t = 0; t < threads; t++) {
+                const size_t count = counts[t][d];
+                counts[t][d] = offset;
+                offset += count;
+            }
+        }
+
+        runThreads([&](size_t t) {
+            auto& next = counts[t];
+            for (size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+                scratch[next[(entries[i].radix >> shift) & (digits - 1)]++] = entries[i];
+            }
+        });
+        entries.swap(scratch);
+    }
+
+    std::vector<std::pair<KeyType, ValType>> sorted;
+    sorted.reserve(n);
+    for (const auto& entry : entries) {
+        sorted.push_back(std::move(items[entry.index]));
+    }
+    items.swap(sorted);
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::buildSorted(const std::vector<std::pair<KeyType, ValType>>& items) {
+
+    // Each run of equal values becomes one list node, its keys linked into the node's bucket.
+    // This stays on one thread: the key index is a single table, and linking is a small share of the work.
+    auto node = vals_.end();
+    for (size_t i = 0; i < items.size(); i++) {
+        if (i == 0 || items[i].second != items[i - 1].second) {
+            node = vals_.insert(vals_.end(), ValNode{items[i].second});
+        }
+        auto [entry, inserted] = keys_.try_emplace(items[i].first);
+        if (!inserted) {
+            throw std::invalid_argument("Duplicate key in priority_map bulk load.");
+        }
+        link(&*entry, node);
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+std::pair<KeyType, ValType> priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::top() const {
     if (vals_.empty()) {
         throw std::out_of_range("Can't access top on an empty priority_map.");
     }
-    const auto val = vals_.front();
-    if (valToKeys_.at(val).empty()) {
+    const auto& node = vals_.front();
+    if (node.head == nullptr) {
         throw std::logic_error("Inconsistent state: Val with no keys.");
     }
     // Return a pair consisting of one of the keys and the value.
-    return {*(valToKeys_.at(val).begin()), val};
+    return {node.head->first, node.val};
 }
 
 template<
     typename KeyType,
     typename ValType,
     typename Compare,
-    typename Hash
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
 >
-void priority_map<KeyType, ValType, Compare, Hash>::pop() {
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::pop() {
     if (vals_.empty()) {
         throw std::out_of_range("Can't pop from empty priority_map.");
     }
-
-    auto oldIt = vals_.begin();
-    if (valToKeys_[*oldIt].empty()) {
+    if (vals_.front().head == nullptr) {
         throw std::logic_error("Inconsistent state: Val with no keys.");
     }
-    KeyType key = *(valToKeys_[*oldIt].begin());
-
-    valToKeys_[*oldIt].erase(key);
-    keys_.erase(key);
+    try_pop();
+}
 
-    // Remove node if it's empty
-    if (valToKeys_[*oldIt].empty()) {
-        valToKeys_.erase(*oldIt); // For now avoid memory bloat
-        vals_.erase(oldIt);
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+std::optional<std::pair<KeyType, ValType>> priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::try_top() const noexcept(nothrow_lookup_ && std::is_nothrow_copy_constructible<KeyType>::value) {
+    if (vals_.empty()) {
+        return std::nullopt;
     }
+    const auto& node = vals_.front();
+    return std::make_pair(node.head->first, node.val);
 }
 
 template<
     typename KeyType,
     typename ValType,
     typename Compare,
-    typename Hash
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
 >
-void priority_map<KeyType, ValType, Compare, Hash>::insert(const KeyType& key, const ValType& newVal) {
-
-    if (keys_.find(key) == keys_.end()) {
+bool priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::try_pop() noexcept(nothrow_lookup_) {
+    if (vals_.empty()) {
+        return false;
+    }
 
-        valToKeys_[0].insert(key);
+    auto node = vals_.begin();
+    entry_type* entry = node->head;
+    unlink(entry);
 
-        // True if minHeap
-        if (comp_(0, 1)) {
+    // Erase through the entry's own copy of the key to avoid copying it
+    keys_.erase(entry->first);
 
-            // Linear search towards end
-            auto insertionPoint = std::find_if(vals_.begin(), vals_.end(),
-            [&](const auto val) {
-                return val >= 0;
-            });
+    // Remove node if it's empty
+    if (node->head == nullptr) {
+        eraseVal(node);
+    }
+    return true;
+}
 
-            if (insertionPoint == vals_.end() || (*insertionPoint) != 0) {
-                insertionPoint = vals_.insert(insertionPoint, 0);
-            }
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+template<typename OutputIt>
+OutputIt priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::pop_top_bucket(OutputIt out) {
+    if (vals_.empty()) {
+        return out;
+    }
 
-            keys_[key] = insertionPoint;
+    // Drop the whole bucket at once instead of erasing its keys one by one
+    auto node = vals_.begin();
+    for (entry_type* entry = node->head; entry != nullptr;) {
+        entry_type* next = entry->second.next;
+        *out++ = entry->first;
+        keys_.erase(entry->first);
+        entry = next;
+    }
+    node->head = nullptr;
+    eraseVal(node);
+    return out;
+}
 
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+std::vector<std::pair<KeyType, ValType>> priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::top_k(size_t k) const {
+    std::vector<std::pair<KeyType, ValType>> result;
+    result.reserve(std::min(k, size()));
+
+    // Walk the distinct values from the top, taking keys bucket by bucket
+    for (auto node = vals_.begin(); node != vals_.end() && result.size() < k; ++node) {
+        for (const entry_type* entry = node->head; entry != nullptr && result.size() < k; entry = entry->second.next) {
+            result.emplace_back(entry->first, node->val);
         }
-        // maxHeap
-        else {
+    }
+    return result;
+}
 
-            // Linear search towards begin
-            auto insertionPoint = std::find_if(vals_.rbegin(), vals_.rend(),
-            [&](const auto val) {
-                return val >= 0;
-            });
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+const ValType* priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::find(const KeyType& key) const noexcept(nothrow_lookup_) {
+    auto it = keys_.find(key);
+    if (it == keys_.end()) {
+        return nullptr;
+    }
+    return &it->second.node->val;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+ValType priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::value_or(const KeyType& key, const ValType& dflt) const noexcept(nothrow_lookup_) {
+    const ValType* val = find(key);
+    return val ? *val : dflt;
+}
 
-            if (insertionPoint == vals_.rend() || (*insertionPoint) != 0) {
-                auto newIt = vals_.insert(insertionPoint.base(), 0);
-                keys_[key] = newIt;
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+ValType priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::at(const KeyType& key) const {
+    const ValType* val = find(key);
+    if (!val) {
+        throw std::out_of_range("Key not found in priority_map.");
+    }
+    return *val;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+template<typename InputIt>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::increment_many(InputIt first, InputIt last, const ValType& delta) {
+    std::unordered_map<KeyType, ValType, Hash> pending;
+    pending.reserve(batchBlock_);
+    while (first != last) {
+
+        // Sum the deltas of repeated keys in a block, then move each key between buckets once
+        for (size_t n = 0; n < batchBlock_ && first != last; ++n, ++first) {
+            pending[*first] += delta;
+        }
+        for (const auto& [key, sum] : pending) {
+            auto it = keys_.find(key);
+            if (it == keys_.end()) {
+                insert(key, sum);
             }
             else {
-                keys_[key] = std::next(insertionPoint).base();
+                update(key, it->second.node->val + sum);
             }
         }
+        pending.clear();
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::insert(const KeyType& key, const ValType& newVal) {
 
+    if (keys_.find(key) == keys_.end()) {
+        insertNew(key, newVal);
+        return;
     }
 
     update(key, newVal);
@@ -239,71 +749,208 @@ template<
     typename KeyType,
     typename ValType,
     typename Compare,
-    typename Hash
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
 >
-void priority_map<KeyType, ValType, Compare, Hash>::update(const KeyType& key, const ValType& newVal) {
 
-    auto oldIt = keys_[key];
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::insertNew(const KeyType& key, const ValType& val) {
+    entry_type* entry = &*keys_.try_emplace(key).first;
+    try {
+        // Counts start at 0 and grow, so new keys usually land near the bottom of the list
+        link(entry, findOrInsertVal(val, comp_(0, 1) ? vals_.begin() : vals_.end()));
+    }
+    catch (...) {
+        keys_.erase(key);
+        throw;
+    }
+}
 
-    // Save Old Value
-    ValType oldVal = *oldIt;
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
 
-    if (oldVal == newVal) return;
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::link(entry_type* entry, typename list_type::iterator node) {
+    Slot& slot = entry->second;
+    slot.node = node;
+    slot.prev = nullptr;
+    slot.next = node->head;
+    if (node->head != nullptr) {
+        node->head->second.prev = entry;
+    }
+    node->head = entry;
+}
 
-    // Remove the key from the old association
-    keys_.erase(key);
-    valToKeys_[oldVal].erase(key);
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
 
-    // Make new association
-    valToKeys_[newVal].insert(key);
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::unlink(entry_type* entry) {
+    Slot& slot = entry->second;
+    if (slot.prev != nullptr) {
+        slot.prev->second.next = slot.next;
+    }
+    else {
+        slot.node->head = slot.next;
+    }
+    if (slot.next != nullptr) {
+        slot.next->second.prev = slot.prev;
+    }
+}
 
-    // True if minHeap and oldVal < newVal or if maxHeap and oldVal > newVal
-    if (comp_(oldVal, newVal)) {
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
 
-        // Linear search towards end
-        auto insertionPoint = std::find_if(oldIt, vals_.end(),
-        [&](const auto val) {
-            if (comp_(1,0)) {
-                return val <= newVal;
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::relink(const priority_map& other) {
+    for (const auto& otherNode : other.vals_) {
+        auto node = vals_.insert(vals_.end(), ValNode{otherNode.val});
+
+        // Append rather than push, keeping other's bucket order
+        entry_type* last = nullptr;
+        for (const entry_type* otherEntry = otherNode.head; otherEntry != nullptr; otherEntry = otherEntry->second.next) {
+            entry_type* entry = &*keys_.find(otherEntry->first);
+            entry->second = Slot{node, last, nullptr};
+            if (last != nullptr) {
+                last->second.next = entry;
             }
-            return val >= newVal;
-        });
+            else {
+                node->head = entry;
+            }
+            last = entry;
+        }
+    }
+}
 
-        if (insertionPoint == vals_.end() || (*insertionPoint) != newVal) {
-            insertionPoint = vals_.insert(insertionPoint, newVal);
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+typename priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::list_type::iterator
+priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::findOrInsertVal(const ValType& val, typename list_type::iterator hint) {
+
+    // Look for pos, the first node that doesn't come before val, a few steps from hint
+    auto pos = hint;
+    bool found;
+    if (pos != vals_.end() && comp_(pos->val, val)) {
+        size_t steps = 0;
+        do {
+            ++pos;
+        } while (++steps < shortWalk_ && pos != vals_.end() && comp_(pos->val, val));
+        found = pos == vals_.end() || !comp_(pos->val, val);
+    }
+    else {
+        for (size_t steps = 0; steps < shortWalk_ && pos != vals_.begin() && !comp_(std::prev(pos)->val, val); steps++) {
+            --pos;
         }
+        found = pos == vals_.begin() || comp_(std::prev(pos)->val, val);
+    }
 
-        keys_[key] = insertionPoint;
+    // Far moves use the ordered index instead of walking the list
+    auto indexPos = valIndex_.end();
+    if (!found) {
+        if (!valIndexed_) {
+            buildValIndex();
+        }
+        nearInserts_ = 0;
+        indexPos = valIndex_.lower_bound(val);
+        pos = indexPos == valIndex_.end() ? vals_.end() : indexPos->second;
+    }
 
+    if (pos != vals_.end() && pos->val == val) {
+        return pos;
     }
-    // minHeap and oldVal > newVal or maxHeap and oldVal < newVal
-    else {
-        // Need to search in reverse
-        typename std::list<ValType>::reverse_iterator oldRit(oldIt); // oldRit will point one element closer to begin
-
-        // Linear search towards begin
-        auto insertionPoint = std::find_if(oldRit, vals_.rend(),
-        [&](const auto val) {
-            if (comp_(0,1)) {
-                return val <= newVal;
-            }
-            return val >= newVal;
-        });
+    pos = vals_.insert(pos, ValNode{val});
 
-        if (insertionPoint == vals_.rend() || (*insertionPoint) != newVal) {
-            auto newIt = vals_.insert(insertionPoint.base(), newVal);
-            keys_[key] = newIt;
-            keys_[key] = std::next(insertionPoint).base();
+    if (valIndexed_) {
+        if (!found) {
+            valIndex_.emplace_hint(indexPos, val, pos);
+        }
+        // Once keeping the index costs more than rebuilding it, as in counting, drop it
+        else if (++nearInserts_ > vals_.size()) {
+            valIndex_.clear();
+            valIndexed_ = false;
         }
         else {
-            keys_[key] = std::next(insertionPoint).base();
+            valIndex_.emplace(val, pos);
         }
     }
+    return pos;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::eraseVal(typename list_type::iterator it) {
+    if (valIndexed_) {
+        valIndex_.erase(it->val);
+    }
+    vals_.erase(it);
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::buildValIndex() {
+    valIndex_.clear();
+    for (auto it = vals_.begin(); it != vals_.end(); ++it) {
+        valIndex_.emplace_hint(valIndex_.end(), it->val, it);
+    }
+    valIndexed_ = true;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+void priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::update(const KeyType& key, const ValType& newVal) {
+
+    // Look the key up once and move its entry between buckets in place
+    entry_type* entry = &*keys_.find(key);
+    auto oldIt = entry->second.node;
+
+    if (oldIt->val == newVal) return;
+
+    auto newIt = findOrInsertVal(newVal, oldIt);
+    unlink(entry);
+    link(entry, newIt);
 
     // Remove the old node if it's empty
-    if (valToKeys_[oldVal].empty()) {
-        valToKeys_.erase(*oldIt); // For now avoid memory bloat
-        vals_.erase(oldIt);
+    if (oldIt->head == nullptr) {
+        eraseVal(oldIt);
     }
 
 }
@@ -312,13 +959,31 @@ template<
     typename KeyType,
     typename ValType,
     typename Compare,
-    typename Hash
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+std::optional<ValType> priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::get(const KeyType& key) const noexcept(nothrow_lookup_) {
+    const ValType* val = find(key);
+    if (!val) {
+        return std::nullopt;
+    }
+    return *val;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
 >
-typename priority_map<KeyType, ValType, Compare, Hash>::Proxy priority_map<KeyType, ValType, Compare, Hash>::operator[](const KeyType& key) {
+typename priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::Proxy priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::operator[](const KeyType& key) {
 
     // If the key doesn't exist, create a new node with value 0
     if (keys_.find(key) == keys_.end()) {
-        insert(key, 0);
+        insertNew(key, 0);
     }
     return Proxy(this, key);
 }
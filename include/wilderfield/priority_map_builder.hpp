@@ -0,0 +1,89 @@
+/**
+ * @file priority_map_builder.hpp
+ * @brief Priority Map Builder Template Class Definition
+ *
+ * Defines a counting front end for one-shot jobs such as word counts. Values
+ * are accumulated in a plain hash table with no ordering, and the ordered
+ * priority map is built once at the end.
+ */
+
+#ifndef WILDERFIELD_PRIORITY_MAP_BUILDER_HPP
+#define WILDERFIELD_PRIORITY_MAP_BUILDER_HPP
+
+#include "wilderfield/priority_map.hpp"
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace wilderfield {
+
+/**
+ * @brief Priority map builder class
+ *
+ * Every increment is a single hash table update, where priority_map would also
+ * move the key between value buckets. finalize() then groups all keys by value
+ * with the priority_map bulk load, which uses a radix sort for integral values.
+ *
+ * @tparam KeyType The type of the keys.
+ * @tparam ValType The type of the values (priorities), must be numeric.
+ * @tparam Compare Comparison class used to maintain the ordering of values.
+ * @tparam Hash Hashing class used for keys.
+ * @tparam KeyIndex Map template used to index keys of the built map, see unordered_key_index.
+ * @tparam Allocator Default constructible allocator used for all nodes, rebound as needed.
+ */
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare = std::greater<ValType>,
+    typename Hash = std::hash<KeyType>,
+    template<typename, typename, typename, typename> class KeyIndex = unordered_key_index,
+    typename Allocator = std::allocator<KeyType>
+>
+class priority_map_builder final {
+
+static_assert(std::is_arithmetic<ValType>::value, "ValType must be a numeric type.");
+
+public:
+    using map_type = priority_map<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>; ///< Type of the built priority map.
+
+private:
+    std::unordered_map<KeyType, ValType, Hash, std::equal_to<KeyType>,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const KeyType, ValType>>> counts_; ///< Unordered values by key.
+
+public:
+
+    size_t size() const { return counts_.size(); } ///< Returns the number of unique keys counted so far.
+
+    bool empty() const { return counts_.empty(); } ///< Checks whether no key was counted yet.
+
+    void reserve(size_t keys) { counts_.reserve(keys); } ///< Reserves room for keys unique keys.
+
+    ValType& operator[](const KeyType& key) { return counts_[key]; } ///< Returns the value of key, inserting it at 0 if absent. No ordering is maintained.
+
+    void add(const KeyType& key, const ValType& delta) { counts_[key] += delta; } ///< Adds delta to the value of key, inserting it at 0 if absent.
+
+    map_type finalize(size_t threads = 0); ///< Builds the priority map from the counted values using up to threads threads, and leaves the builder empty.
+};
+
+// Out-of-line implementation of priority_map_builder methods
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash,
+    template<typename, typename, typename, typename> class KeyIndex,
+    typename Allocator
+>
+typename priority_map_builder<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::map_type priority_map_builder<KeyType, ValType, Compare, Hash, KeyIndex, Allocator>::finalize(size_t threads) {
+    map_type pmap(counts_.begin(), counts_.end(), threads);
+    counts_.clear();
+    return pmap;
+}
+
+} // namespace
+
+#endif // WILDERFIELD_PRIORITY_MAP_BUILDER_HPP
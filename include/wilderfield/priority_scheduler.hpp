@@ -0,0 +1,338 @@
+/**
+ * @file priority_scheduler.hpp
+ * @brief Work-Stealing Priority Scheduler Template Class Definition
+ *
+ * Defines a task scheduler whose workers each keep their ready tasks in a local
+ * priority map, run their most urgent task next, and steal the most urgent task
+ * of another worker when they run out.
+ */
+
+#ifndef WILDERFIELD_PRIORITY_SCHEDULER_HPP
+#define WILDERFIELD_PRIORITY_SCHEDULER_HPP
+
+#include "wilderfield/priority_map.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+
+/**
+ * @brief Work-stealing priority scheduler class
+ *
+ * Runs execute(task) once for every task submitted, on a fixed set of workers.
+ * A task waits in the priority_map of its home worker, chosen by hashing the
+ * task id, until that worker or a thief takes it. Workers always take the top
+ * of a map, so the most urgent waiting task of each map runs first. A waiting
+ * task's priority can be changed from any thread, including from a task, and
+ * increase() and decrease() use the map's single-step update.
+ *
+ * Each map is guarded by a spin lock, held only for a map operation and never
+ * while a task runs. The first exception thrown by a task is kept and
+ * rethrown by wait().
+ *
+ * @tparam TaskId The type of the task ids.
+ * @tparam Priority The type of the priorities, must be integral. Larger runs first.
+ * @tparam Hash Hashing class used for task ids.
+ */
+template<
+    typename TaskId,
+    typename Priority = long,
+    typename Hash = std::hash<TaskId>
+>
+class priority_scheduler final {
+
+static_assert(std::is_integral<Priority>::value, "Priority must be an integral type.");
+
+private:
+    // Test-and-test-and-set lock, yielding after a short spin
+    class spin_lock {
+        std::atomic<bool> locked_{false};
+    public:
+        void lock() {
+            for (unsigned spins = 0; locked_.exchange(true, std::memory_order_acquire); spins++) {
+                while (locked_.load(std::memory_order_relaxed)) {
+                    if (++spins > 64) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+        void unlock() { locked_.store(false, std::memory_order_release); }
+    };
+
+    struct Worker {
+        spin_lock lock;                          ///< Guards ready.
+        priority_map<TaskId, Priority> ready;    ///< Tasks homed here that are waiting to run.
+        std::thread thread;
+    };
+
+    Hash hash_;
+    std::function<void(const TaskId&)> execute_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex stateMutex_;                  ///< Guards sleeping, waking, error and stop.
+    std::condition_variable wake_;           ///< Signals workers that tasks are waiting or they should stop.
+    std::condition_variable idle_;           ///< Signals wait() that every task finished.
+    std::atomic<long> waiting_{0};           ///< Tasks in the maps.
+    std::atomic<std::size_t> unfinished_{0}; ///< Tasks submitted and not yet finished.
+    std::exception_ptr error_;
+    bool stop_ = false;
+
+    Worker& homeOf(const TaskId& task) const {
+        const std::uint64_t h = static_cast<std::uint64_t>(hash_(task)) * 0x9e3779b97f4a7c15ULL;
+        return *workers_[static_cast<std::size_t>((h >> 32) * workers_.size() >> 32)];
+    }
+
+    // Pop the top task of worker's map, if any.
+    static std::optional<TaskId> takeTop(Worker& worker);
+
+    void run(std::size_t self);
+
+    // Stop the workers and join those started so far.
+    void stopWorkers();
+
+public:
+
+    priority_scheduler(std::size_t threads, std::function<void(const TaskId&)> execute, const Hash& hash = Hash()); ///< Starts threads workers, one per hardware thread when threads is 0.
+
+    priority_scheduler(const priority_scheduler&) = delete;
+    priority_scheduler& operator=(const priority_scheduler&) = delete;
+    ~priority_scheduler(); ///< Runs the tasks still waiting, then stops the workers.
+
+    std::size_t thread_count() const { return workers_.size(); } ///< Returns the number of workers.
+
+    void submit(const TaskId& task, Priority priority); ///< Queues task. Throws std::invalid_argument if task is already waiting.
+
+    bool increase(const TaskId& task); ///< Raises the priority of a waiting task by one. Returns false if task is not waiting.
+
+    bool decrease(const TaskId& task); ///< Lowers the priority of a waiting task by one. Returns false if task is not waiting.
+
+    bool reprioritize(const TaskId& task, Priority priority); ///< Sets the priority of a waiting task. Returns false if task is not waiting.
+
+    std::optional<Priority> priority(const TaskId& task) const; ///< Returns the priority of a waiting task, or std::nullopt if it is not waiting.
+
+    void wait(); ///< Waits until every task submitted so far finished. Rethrows the first exception a task threw. Must not be called from a task.
+};
+
+// Out-of-line implementation of priority_scheduler methods
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+priority_scheduler<TaskId, Priority, Hash>::priority_scheduler(std::size_t threads, std::function<void(const TaskId&)> execute, const Hash& hash)
+    : hash_(hash), execute_(std::move(execute)) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    try {
+        for (std::size_t i = 0; i < threads; i++) {
+            workers_[i]->thread = std::thread(&priority_scheduler::run, this, i);
+        }
+    }
+    catch (...) {
+        stopWorkers(); // Running workers would otherwise terminate the program once destroyed
+        throw;
+    }
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+priority_scheduler<TaskId, Priority, Hash>::~priority_scheduler() {
+    stopWorkers();
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+void priority_scheduler<TaskId, Priority, Hash>::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+std::optional<TaskId> priority_scheduler<TaskId, Priority, Hash>::takeTop(Worker& worker) {
+    std::lock_guard<spin_lock> lock(worker.lock);
+    if (worker.ready.empty()) {
+        return std::nullopt;
+    }
+    TaskId task = worker.ready.top().first;
+    worker.ready.pop();
+    return task;
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+void priority_scheduler<TaskId, Priority, Hash>::run(std::size_t self) {
+    for (;;) {
+        // Own map first, then steal, starting after self so thieves spread over the victims
+        std::optional<TaskId> task;
+        for (std::size_t i = 0; i < workers_.size() && !task; i++) {
+            task = takeTop(*workers_[(self + i) % workers_.size()]);
+        }
+
+        if (!task) {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            wake_.wait(lock, [&] { return stop_ || waiting_.load() > 0; });
+            if (stop_ && waiting_.load() <= 0) {
+                return;
+            }
+            continue;
+        }
+        waiting_--;
+
+        try {
+            execute_(*task);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+
+        if (--unfinished_ == 0) {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            idle_.notify_all();
+        }
+    }
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+void priority_scheduler<TaskId, Priority, Hash>::submit(const TaskId& task, Priority priority) {
+    Worker& home = homeOf(task);
+    {
+        std::lock_guard<spin_lock> lock(home.lock);
+        if (home.ready.contains(task)) {
+            throw std::invalid_argument("Task already waiting in priority_scheduler.");
+        }
+        home.ready[task] = priority;
+
+        // Count the task only once it is queued, so a failed insert can't leave wait() hanging
+        unfinished_++;
+    }
+    {
+        // Raise waiting_ under the lock so a worker about to sleep sees it
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        waiting_++;
+    }
+    wake_.notify_one();
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+bool priority_scheduler<TaskId, Priority, Hash>::increase(const TaskId& task) {
+    Worker& home = homeOf(task);
+    std::lock_guard<spin_lock> lock(home.lock);
+    if (!home.ready.contains(task)) {
+        return false;
+    }
+    ++home.ready[task];
+    return true;
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+bool priority_scheduler<TaskId, Priority, Hash>::decrease(const TaskId& task) {
+    Worker& home = homeOf(task);
+    std::lock_guard<spin_lock> lock(home.lock);
+    if (!home.ready.contains(task)) {
+        return false;
+    }
+    --home.ready[task];
+    return true;
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+bool priority_scheduler<TaskId, Priority, Hash>::reprioritize(const TaskId& task, Priority priority) {
+    Worker& home = homeOf(task);
+    std::lock_guard<spin_lock> lock(home.lock);
+    if (!home.ready.contains(task)) {
+        return false;
+    }
+    home.ready[task] = priority;
+    return true;
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+std::optional<Priority> priority_scheduler<TaskId, Priority, Hash>::priority(const TaskId& task) const {
+    Worker& home = homeOf(task);
+    std::lock_guard<spin_lock> lock(home.lock);
+    return home.ready.get(task);
+}
+
+template<
+    typename TaskId,
+    typename Priority,
+    typename Hash
+>
+void priority_scheduler<TaskId, Priority, Hash>::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    idle_.wait(lock, [&] { return unfinished_.load() == 0; });
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace
+
+#endif // WILDERFIELD_PRIORITY_SCHEDULER_HPP
@@ -0,0 +1,421 @@
+/**
+ * @file sharded_priority_map.hpp
+ * @brief NUMA Sharded Priority Map Template Class Definition
+ *
+ * Defines a priority map split into shards that are each owned by a worker
+ * thread running on, and allocating from, one NUMA node. Keys are routed to
+ * shards by hash, and queries merge the shards' answers.
+ */
+
+#ifndef WILDERFIELD_SHARDED_PRIORITY_MAP_HPP
+#define WILDERFIELD_SHARDED_PRIORITY_MAP_HPP
+
+#include "wilderfield/priority_map.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(WILDERFIELD_HAS_LIBNUMA)
+#include <numa.h>
+#endif
+
+namespace wilderfield {
+
+/**
+ * @brief NUMA sharded priority map class
+ *
+ * Holds one priority_map per shard. Each shard has a worker thread that applies
+ * the updates routed to it, so the shard's nodes are only ever allocated and
+ * touched by that thread. When built with WILDERFIELD_HAS_LIBNUMA (and linked
+ * against libnuma), the worker of shard i runs on NUMA node i modulo the node
+ * count and prefers that node's memory. Otherwise the workers are left to the
+ * scheduler and the map behaves as a plain sharded map.
+ *
+ * Updates are queued and applied asynchronously, in submission order per
+ * submitting thread. Queries first wait for every queued update to be applied.
+ * Updates and queries may be issued from any number of threads.
+ *
+ * @tparam KeyType The type of the keys.
+ * @tparam ValType The type of the values (priorities), must be numeric.
+ * @tparam Compare Comparison class used to maintain the ordering of values.
+ * @tparam Hash Hashing class used for keys.
+ */
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare = std::greater<ValType>,
+    typename Hash = std::hash<KeyType>
+>
+class sharded_priority_map final {
+
+public:
+    using shard_type = priority_map<KeyType, ValType, Compare, Hash>; ///< Priority map held by each shard.
+
+private:
+    enum class OpKind { Add, Assign, Erase };
+
+    struct Op {
+        OpKind kind;
+        KeyType key;
+        ValType val;
+    };
+
+    struct Shard {
+        int node = 0;
+
+        std::mutex queueMutex;            ///< Guards pending, submitted, applied, error and stop.
+        std::condition_variable wake;     ///< Signals the worker that updates are pending or it should stop.
+        std::condition_variable drained;  ///< Signals waiters that applied advanced.
+        std::vector<Op> pending;          ///< Updates not yet taken by the worker.
+        std::uint64_t submitted = 0;      ///< Updates ever queued.
+        std::uint64_t applied = 0;        ///< Updates ever applied.
+        std::exception_ptr error;         ///< First exception thrown while applying updates.
+        bool stop = false;
+
+        mutable std::mutex mapMutex;      ///< Guards map while the worker applies a batch.
+        shard_type map;
+
+        std::thread worker;
+    };
+
+    Hash hash_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    // Shard owning key, from the top bits of a Fibonacci hash so the shard's own
+    // hash table still sees well spread low bits.
+    Shard& shardOf(const KeyType& key) const {
+        const std::uint64_t h = static_cast<std::uint64_t>(hash_(key)) * 0x9e3779b97f4a7c15ULL;
+        return *shards_[static_cast<std::size_t>((h >> 32) * shards_.size() >> 32)];
+    }
+
+    void submit(Op op);
+
+    static void run(Shard& shard);
+
+    // Stop every shard and join the workers started so far.
+    void stopWorkers();
+
+    // Bind the calling thread and its future allocations to node.
+    static void bindToNode(int node);
+
+public:
+
+    explicit sharded_priority_map(std::size_t shards = 0, const Hash& hash = Hash()); ///< Starts shards worker threads, one per NUMA node when shards is 0.
+
+    sharded_priority_map(const sharded_priority_map&) = delete;
+    sharded_priority_map& operator=(const sharded_priority_map&) = delete;
+    ~sharded_priority_map();
+
+    static std::size_t numa_nodes(); ///< Returns the number of NUMA nodes shards are spread over, 1 without libnuma.
+
+    size_t shard_count() const { return shards_.size(); } ///< Returns the number of shards.
+
+    int shard_node(size_t shard) const { return shards_[shard]->node; } ///< Returns the NUMA node shard is placed on.
+
+    void add(const KeyType& key, const ValType& delta); ///< Queues adding delta to the value of key, inserting it at 0 if absent.
+
+    void assign(const KeyType& key, const ValType& val); ///< Queues setting the value of key.
+
+    void erase(const KeyType& key); ///< Queues erasing key.
+
+    void flush(); ///< Waits until every update queued so far is applied. Rethrows an exception thrown while applying one.
+
+    size_t size(); ///< Returns the number of unique keys across all shards.
+
+    std::optional<ValType> get(const KeyType& key); ///< Returns the value of key, or std::nullopt if key is absent.
+
+    std::vector<std::pair<KeyType, ValType>> top_k(size_t k); ///< Returns up to k elements with the highest priority across all shards, in priority order.
+};
+
+// Out-of-line implementation of sharded_priority_map methods
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::size_t sharded_priority_map<KeyType, ValType, Compare, Hash>::numa_nodes() {
+#if defined(WILDERFIELD_HAS_LIBNUMA)
+    if (numa_available() >= 0) {
+        return static_cast<std::size_t>(std::max(numa_num_configured_nodes(), 1));
+    }
+#endif
+    return 1;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::bindToNode(int node) {
+#if defined(WILDERFIELD_HAS_LIBNUMA)
+    if (numa_available() >= 0) {
+        numa_run_on_node(node);
+        numa_set_preferred(node);
+    }
+#else
+    (void)node;
+#endif
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+sharded_priority_map<KeyType, ValType, Compare, Hash>::sharded_priority_map(std::size_t shards, const Hash& hash) : hash_(hash) {
+    const std::size_t nodes = numa_nodes();
+    if (shards == 0) {
+        shards = nodes;
+    }
+    shards_.reserve(shards);
+    for (std::size_t i = 0; i < shards; i++) {
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->node = static_cast<int>(i % nodes);
+    }
+    try {
+        for (auto& shard : shards_) {
+            shard->worker = std::thread(&sharded_priority_map::run, std::ref(*shard));
+        }
+    }
+    catch (...) {
+        stopWorkers(); // Running workers would otherwise terminate the program once destroyed
+        throw;
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+sharded_priority_map<KeyType, ValType, Compare, Hash>::~sharded_priority_map() {
+    stopWorkers();
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::stopWorkers() {
+    for (auto& shard : shards_) {
+        {
+            std::lock_guard<std::mutex> lock(shard->queueMutex);
+            shard->stop = true;
+        }
+        shard->wake.notify_one();
+    }
+    for (auto& shard : shards_) {
+        if (shard->worker.joinable()) {
+            shard->worker.join();
+        }
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::run(Shard& shard) {
+    bindToNode(shard.node);
+
+    std::vector<Op> batch;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(shard.queueMutex);
+            shard.wake.wait(lock, [&] { return shard.stop || !shard.pending.empty(); });
+            if (shard.pending.empty()) {
+                return; // Stopping, and every queued update is applied
+            }
+            batch.swap(shard.pending);
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(shard.mapMutex);
+            for (const auto& op : batch) {
+                try {
+                    switch (op.kind) {
+                    case OpKind::Add:
+                        shard.map[op.key] = shard.map.value_or(op.key, 0) + op.val;
+                        break;
+                    case OpKind::Assign:
+                        shard.map[op.key] = op.val;
+                        break;
+                    case OpKind::Erase:
+                        shard.map.erase(op.key);
+                        break;
+                    }
+                }
+                catch (...) {
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(shard.queueMutex);
+            shard.applied += batch.size();
+            if (error && !shard.error) {
+                shard.error = error;
+            }
+        }
+        shard.drained.notify_all();
+        batch.clear();
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::submit(Op op) {
+    Shard& shard = shardOf(op.key);
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(shard.queueMutex);
+        wasEmpty = shard.pending.empty();
+        shard.pending.push_back(std::move(op));
+        shard.submitted++;
+    }
+    // A non-empty queue means the worker is already due to wake up
+    if (wasEmpty) {
+        shard.wake.notify_one();
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::add(const KeyType& key, const ValType& delta) {
+    submit(Op{OpKind::Add, key, delta});
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::assign(const KeyType& key, const ValType& val) {
+    submit(Op{OpKind::Assign, key, val});
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::erase(const KeyType& key) {
+    submit(Op{OpKind::Erase, key, ValType()});
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+void sharded_priority_map<KeyType, ValType, Compare, Hash>::flush() {
+    for (auto& shard : shards_) {
+        std::unique_lock<std::mutex> lock(shard->queueMutex);
+        const std::uint64_t target = shard->submitted;
+        shard->drained.wait(lock, [&] { return shard->applied >= target; });
+        if (shard->error) {
+            std::exception_ptr error = shard->error;
+            shard->error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+size_t sharded_priority_map<KeyType, ValType, Compare, Hash>::size() {
+    flush();
+    size_t total = 0;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mapMutex);
+        total += shard->map.size();
+    }
+    return total;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::optional<ValType> sharded_priority_map<KeyType, ValType, Compare, Hash>::get(const KeyType& key) {
+    flush();
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mapMutex);
+    return shard.map.get(key);
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    typename Compare,
+    typename Hash
+>
+std::vector<std::pair<KeyType, ValType>> sharded_priority_map<KeyType, ValType, Compare, Hash>::top_k(size_t k) {
+    flush();
+
+    // The global top k is among the union of every shard's top k
+    std::vector<std::pair<KeyType, ValType>> merged;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mapMutex);
+        auto local = shard->map.top_k(k);
+        merged.insert(merged.end(), std::make_move_iterator(local.begin()), std::make_move_iterator(local.end()));
+    }
+
+    Compare comp;
+    auto byPriority = [&](const std::pair<KeyType, ValType>& a, const std::pair<KeyType, ValType>& b) {
+        return comp(a.second, b.second);
+    };
+    if (merged.size() > k) {
+        std::partial_sort(merged.begin(), merged.begin() + k, merged.end(), byPriority);
+        merged.resize(k);
+    }
+    else {
+        std::sort(merged.begin(), merged.end(), byPriority);
+    }
+    return merged;
+}
+
+} // namespace
+
+#endif // WILDERFIELD_SHARDED_PRIORITY_MAP_HPP
@@ -0,0 +1,353 @@
+/**
+ * @file small_priority_map.hpp
+ * @brief Small Priority Map Template Class Definition
+ *
+ * Defines a priority map that keeps up to N entries inline in sorted arrays and
+ * only promotes itself to a heap allocated priority_map once it grows past N.
+ */
+
+#ifndef WILDERFIELD_SMALL_PRIORITY_MAP_HPP
+#define WILDERFIELD_SMALL_PRIORITY_MAP_HPP
+
+#include "wilderfield/priority_map.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace wilderfield {
+
+/**
+ * @brief Small priority map class
+ *
+ * Holds up to N keys and their values in two inline arrays sorted by priority,
+ * with the top element at the back. Lookups are linear scans over the key array,
+ * and updates shift the entry to its new position. An instance with at most N
+ * keys performs no heap allocation. Inserting key N+1 promotes the map to a full
+ * priority_map, which it keeps using from then on.
+ *
+ * @tparam KeyType The type of the keys, must be default constructible.
+ * @tparam ValType The type of the values (priorities), must be numeric.
+ * @tparam N The number of entries stored inline before promotion.
+ * @tparam Compare Comparison class used to maintain the ordering of values.
+ * @tparam Hash Hashing class used for keys once promoted.
+ */
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N = 8,
+    typename Compare = std::greater<ValType>,
+    typename Hash = std::hash<KeyType>
+>
+class small_priority_map final {
+
+static_assert(std::is_arithmetic<ValType>::value, "ValType must be a numeric type.");
+static_assert(std::is_default_constructible<KeyType>::value, "KeyType must be default constructible.");
+static_assert(N > 0, "N must be positive.");
+
+public:
+    using large_map_type = priority_map<KeyType, ValType, Compare, Hash>; ///< Map used once promoted.
+
+private:
+    Compare comp_;
+
+    std::array<KeyType, N> keys_{}; ///< Inline keys, sorted by priority with the top at the back.
+    std::array<ValType, N> vals_{}; ///< Inline values, parallel to keys_.
+    std::size_t size_ = 0;          ///< Number of inline entries in use.
+
+    std::unique_ptr<large_map_type> large_; ///< Full priority map, set once promoted.
+
+    // Private member functions
+
+    // Index of key in the inline arrays, or size_ if absent.
+    std::size_t find(const KeyType& key) const {
+        return std::find(keys_.begin(), keys_.begin() + size_, key) - keys_.begin();
+    }
+
+    // Shift the entry at idx until the arrays are sorted again.
+    void reposition(std::size_t idx);
+
+    // Move all inline entries into a newly allocated priority_map.
+    void promote();
+
+    // Insert new key
+    void insert(const KeyType& key, const ValType& newVal);
+
+    // Update Key with Val
+    // This function can be used for increment, decrement, or assigning a new val
+    void update(const KeyType& key, const ValType& newVal);
+
+    // Get the value associated with a key.
+    ValType getVal(const KeyType& key) const {
+        if (large_) {
+            return large_->at(key);
+        }
+        return vals_[find(key)];
+    }
+
+public:
+
+    small_priority_map() = default;
+
+    small_priority_map(const small_priority_map& other); ///< Copies the entries, including a deep copy of the promoted map if any.
+
+    small_priority_map& operator=(const small_priority_map& other); ///< Copies the entries, including a deep copy of the promoted map if any.
+
+    small_priority_map(small_priority_map&&) = default;
+
+    small_priority_map& operator=(small_priority_map&&) = default;
+
+    static constexpr std::size_t inline_capacity() { return N; } ///< Returns the number of entries stored before promotion.
+
+    bool is_inline() const { return !large_; } ///< Checks whether the map still stores its entries inline.
+
+    size_t size() const { return large_ ? large_->size() : size_; } ///< Returns the number of unique keys in the priority map.
+
+    bool empty() const { return size() == 0; } ///< Checks whether the priority map is empty.
+
+    size_t count(const KeyType& key) const { return large_ ? large_->count(key) : find(key) != size_; } ///< Returns the count of a particular key in the map.
+
+    std::pair<KeyType, ValType> top() const; ///< Returns the top element (key-value pair) in the priority map.
+
+    size_t erase(const KeyType& key); ///< Erases key from the priority map. Returns the number of elements removed (0 or 1).
+
+    void pop(); ///< Removes the top element from the priority map.
+
+    class Proxy;
+    Proxy operator[](const KeyType& key);
+
+    // Proxy class to handle the increment operation.
+    class Proxy {
+    private:
+        small_priority_map* pm;
+        KeyType key;
+
+    public:
+        Proxy(small_priority_map* pm, const KeyType& key) : pm(pm), key(key) {}
+
+        Proxy& operator++() {
+            pm->update(key, pm->getVal(key)+1);
+            return *this;
+        }
+
+        Proxy operator++(int) {
+            Proxy temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        Proxy& operator--() {
+            pm->update(key, pm->getVal(key)-1);
+            return *this;
+        }
+
+        Proxy operator--(int) {
+            Proxy temp = *this;
+            --(*this);
+            return temp;
+        }
+
+        void operator=(const ValType& val) {pm->update(key, val);}
+
+        operator ValType() const {return pm->getVal(key);}
+    };
+
+};
+
+// Out-of-line implementation of small_priority_map methods
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+small_priority_map<KeyType, ValType, N, Compare, Hash>::small_priority_map(const small_priority_map& other)
+    : comp_(other.comp_), keys_(other.keys_), vals_(other.vals_), size_(other.size_),
+      large_(other.large_ ? std::make_unique<large_map_type>(*other.large_) : nullptr) {}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+small_priority_map<KeyType, ValType, N, Compare, Hash>& small_priority_map<KeyType, ValType, N, Compare, Hash>::operator=(const small_priority_map& other) {
+    if (this != &other) {
+        *this = small_priority_map(other);
+    }
+    return *this;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+void small_priority_map<KeyType, ValType, N, Compare, Hash>::reposition(std::size_t idx) {
+
+    // Move towards the back while the next entry has lower priority
+    while (idx + 1 < size_ && comp_(vals_[idx], vals_[idx + 1])) {
+        std::swap(keys_[idx], keys_[idx + 1]);
+        std::swap(vals_[idx], vals_[idx + 1]);
+        idx++;
+    }
+
+    // Move towards the front while the previous entry has higher priority
+    while (idx > 0 && comp_(vals_[idx - 1], vals_[idx])) {
+        std::swap(keys_[idx], keys_[idx - 1]);
+        std::swap(vals_[idx], vals_[idx - 1]);
+        idx--;
+    }
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+void small_priority_map<KeyType, ValType, N, Compare, Hash>::promote() {
+    auto large = std::make_unique<large_map_type>();
+    for (std::size_t i = 0; i < size_; i++) {
+        (*large)[keys_[i]] = vals_[i];
+    }
+    large_ = std::move(large);
+
+    // Release whatever the inline keys hold
+    std::fill(keys_.begin(), keys_.begin() + size_, KeyType());
+    size_ = 0;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+void small_priority_map<KeyType, ValType, N, Compare, Hash>::insert(const KeyType& key, const ValType& newVal) {
+
+    if (!large_ && size_ == N) {
+        promote();
+    }
+    if (large_) {
+        (*large_)[key] = newVal;
+        return;
+    }
+
+    keys_[size_] = key;
+    vals_[size_] = newVal;
+    reposition(size_++);
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+void small_priority_map<KeyType, ValType, N, Compare, Hash>::update(const KeyType& key, const ValType& newVal) {
+
+    if (large_) {
+        (*large_)[key] = newVal;
+        return;
+    }
+
+    const std::size_t idx = find(key);
+    if (vals_[idx] == newVal) return;
+    vals_[idx] = newVal;
+    reposition(idx);
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+size_t small_priority_map<KeyType, ValType, N, Compare, Hash>::erase(const KeyType& key) {
+    if (large_) {
+        return large_->erase(key);
+    }
+
+    const std::size_t idx = find(key);
+    if (idx == size_) {
+        return 0;
+    }
+
+    // Close the gap, keeping the arrays sorted
+    std::move(keys_.begin() + idx + 1, keys_.begin() + size_, keys_.begin() + idx);
+    std::move(vals_.begin() + idx + 1, vals_.begin() + size_, vals_.begin() + idx);
+    keys_[--size_] = KeyType();
+    return 1;
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+std::pair<KeyType, ValType> small_priority_map<KeyType, ValType, N, Compare, Hash>::top() const {
+    if (large_) {
+        return large_->top();
+    }
+    if (size_ == 0) {
+        throw std::out_of_range("Can't access top on an empty small_priority_map.");
+    }
+    return {keys_[size_ - 1], vals_[size_ - 1]};
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+void small_priority_map<KeyType, ValType, N, Compare, Hash>::pop() {
+    if (large_) {
+        large_->pop();
+        return;
+    }
+    if (size_ == 0) {
+        throw std::out_of_range("Can't pop from empty small_priority_map.");
+    }
+
+    // Reset the vacated slot so it releases what the key held
+    keys_[--size_] = KeyType();
+}
+
+template<
+    typename KeyType,
+    typename ValType,
+    std::size_t N,
+    typename Compare,
+    typename Hash
+>
+typename small_priority_map<KeyType, ValType, N, Compare, Hash>::Proxy small_priority_map<KeyType, ValType, N, Compare, Hash>::operator[](const KeyType& key) {
+
+    // If the key doesn't exist, create a new entry with value 0
+    if (!count(key)) {
+        insert(key, 0);
+    }
+    return Proxy(this, key);
+}
+
+} // namespace
+
+#endif // WILDERFIELD_SMALL_PRIORITY_MAP_HPP
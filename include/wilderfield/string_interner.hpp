@@ -0,0 +1,153 @@
+/**
+ * @file string_interner.hpp
+ * @brief String Interner Class Definition
+ *
+ * Defines an append-only string interner that stores each distinct string once
+ * in an arena and hands out dense 32-bit ids for it.
+ */
+
+#ifndef WILDERFIELD_STRING_INTERNER_HPP
+#define WILDERFIELD_STRING_INTERNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace wilderfield {
+
+/**
+ * @brief String interner class
+ *
+ * Copies every distinct string once into fixed size arena blocks that are never
+ * moved or freed, so the views handed out stay valid for the interner's lifetime.
+ * Ids are assigned densely from 0 in order of first appearance.
+ */
+class string_interner final {
+
+public:
+    using id_type = std::uint32_t; ///< Type of the ids handed out.
+
+private:
+    static constexpr std::size_t blockSize_ = std::size_t(1) << 16; ///< Bytes per arena block.
+
+    std::vector<std::unique_ptr<char[]>> blocks_; ///< Arena blocks holding the string bytes.
+    char* cursor_ = nullptr;                      ///< Next free byte in the current block.
+    std::size_t left_ = 0;                        ///< Free bytes left in the current block.
+    std::size_t bytes_ = 0;                       ///< Total string bytes stored.
+
+    std::vector<std::string_view> views_;                 ///< Map from ids to their strings.
+    std::unordered_map<std::string_view, id_type> ids_; ///< Map from strings to their ids.
+
+    // Copy str into the arena and return a view of the copy.
+    std::string_view store(std::string_view str);
+
+public:
+
+    string_interner() = default;
+    string_interner(const string_interner&) = delete;
+    string_interner& operator=(const string_interner&) = delete;
+    string_interner(string_interner&& other) noexcept; ///< Takes other's strings and arena, leaving other empty.
+    string_interner& operator=(string_interner&& other) noexcept; ///< Takes other's strings and arena, leaving other empty.
+
+    size_t size() const { return views_.size(); } ///< Returns the number of distinct strings interned.
+
+    size_t bytes() const { return bytes_; } ///< Returns the number of string bytes stored in the arena.
+
+    id_type intern(std::string_view str); ///< Returns the id of str, interning it first if it is new.
+
+    std::optional<id_type> find(std::string_view str) const; ///< Returns the id of str, or std::nullopt if it was never interned.
+
+    std::string_view operator[](id_type id) const { return views_[id]; } ///< Returns the string with the given id.
+};
+
+// Out-of-line implementation of string_interner methods
+
+inline string_interner::string_interner(string_interner&& other) noexcept
+    : blocks_(std::move(other.blocks_)), cursor_(other.cursor_), left_(other.left_), bytes_(other.bytes_),
+      views_(std::move(other.views_)), ids_(std::move(other.ids_)) {
+
+    // other must not keep writing into the block it no longer owns
+    other.cursor_ = nullptr;
+    other.left_ = 0;
+    other.bytes_ = 0;
+    other.views_.clear();
+    other.ids_.clear();
+}
+
+inline string_interner& string_interner::operator=(string_interner&& other) noexcept {
+    if (this != &other) {
+        blocks_ = std::move(other.blocks_);
+        cursor_ = other.cursor_;
+        left_ = other.left_;
+        bytes_ = other.bytes_;
+        views_ = std::move(other.views_);
+        ids_ = std::move(other.ids_);
+        other.cursor_ = nullptr;
+        other.left_ = 0;
+        other.bytes_ = 0;
+        other.views_.clear();
+        other.ids_.clear();
+    }
+    return *this;
+}
+
+inline std::string_view string_interner::store(std::string_view str) {
+    bytes_ += str.size();
+    if (str.empty()) {
+        return {};
+    }
+
+    // Oversized strings get a block of their own, leaving the current block in use
+    if (str.size() > blockSize_) {
+        blocks_.emplace_back(new char[str.size()]);
+        std::memcpy(blocks_.back().get(), str.data(), str.size());
+        return {blocks_.back().get(), str.size()};
+    }
+
+    if (str.size() > left_) {
+        blocks_.emplace_back(new char[blockSize_]);
+        cursor_ = blocks_.back().get();
+        left_ = blockSize_;
+    }
+
+    std::memcpy(cursor_, str.data(), str.size());
+    std::string_view stored(cursor_, str.size());
+    cursor_ += str.size();
+    left_ -= str.size();
+    return stored;
+}
+
+inline string_interner::id_type string_interner::intern(std::string_view str) {
+    auto it = ids_.find(str);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (views_.size() > std::numeric_limits<id_type>::max()) {
+        throw std::length_error("Too many strings for string_interner ids.");
+    }
+    const auto id = static_cast<id_type>(views_.size());
+    const std::string_view stored = store(str);
+    views_.push_back(stored);
+    ids_.emplace(stored, id);
+    return id;
+}
+
+inline std::optional<string_interner::id_type> string_interner::find(std::string_view str) const {
+    auto it = ids_.find(str);
+    if (it == ids_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+} // namespace
+
+#endif // WILDERFIELD_STRING_INTERNER_HPP
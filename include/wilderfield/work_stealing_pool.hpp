@@ -0,0 +1,220 @@
+/**
+ * @file work_stealing_pool.hpp
+ * @brief Work-Stealing Thread Pool Class Definition
+ *
+ * Defines a fixed-size thread pool in which every worker has its own task
+ * deque and idle workers steal from the other deques.
+ */
+
+#ifndef WILDERFIELD_WORK_STEALING_POOL_HPP
+#define WILDERFIELD_WORK_STEALING_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace wilderfield {
+
+/**
+ * @brief Work-stealing thread pool class
+ *
+ * A worker takes tasks from the back of its own deque, newest first, and when
+ * that is empty steals the oldest task from the front of another worker's deque.
+ * Tasks submitted from outside the pool are dealt round-robin over the deques.
+ * Tasks submitted by a task go to the deque of the worker running it. Each
+ * deque has its own mutex, so workers only contend when stealing.
+ *
+ * The first exception thrown by a task is kept and rethrown by wait().
+ */
+class work_stealing_pool final {
+
+private:
+    struct Worker {
+        std::mutex mutex;                        ///< Guards tasks.
+        std::deque<std::function<void()>> tasks; ///< Owner pops the back, thieves the front.
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex stateMutex_;            ///< Guards sleeping, waking, error and stop.
+    std::condition_variable wake_;     ///< Signals workers that tasks are queued or they should stop.
+    std::condition_variable idle_;     ///< Signals wait() that every task finished.
+    std::atomic<long> queued_{0};      ///< Tasks in the deques. Briefly negative while a submit races a take.
+    std::atomic<std::size_t> unfinished_{0}; ///< Tasks submitted and not yet finished.
+    std::atomic<std::size_t> next_{0}; ///< Deque for the next task submitted from outside.
+    std::exception_ptr error_;
+    bool stop_ = false;
+
+    // The pool and index of the worker running on this thread, if any
+    static inline thread_local const work_stealing_pool* currentPool_ = nullptr;
+    static inline thread_local std::size_t currentIndex_ = 0;
+
+    // Index of the worker the calling thread is, or the worker count outside the pool.
+    std::size_t currentWorker() const;
+
+    // Take a task from worker self's deque, or steal one. Returns false if all are empty.
+    bool take(std::size_t self, std::function<void()>& task);
+
+    void run(std::size_t self);
+
+    // Stop the workers and join those started so far.
+    void stopWorkers();
+
+public:
+
+    explicit work_stealing_pool(std::size_t threads = 0); ///< Starts threads workers, one per hardware thread when threads is 0.
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+    ~work_stealing_pool();
+
+    std::size_t thread_count() const { return workers_.size(); } ///< Returns the number of workers.
+
+    void submit(std::function<void()> task); ///< Queues task. May be called from any thread, including a task.
+
+    void wait(); ///< Waits until every task submitted so far finished. Rethrows the first exception a task threw. Must not be called from a task.
+};
+
+// Out-of-line implementation of work_stealing_pool methods
+
+inline work_stealing_pool::work_stealing_pool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    try {
+        for (std::size_t i = 0; i < threads; i++) {
+            workers_[i]->thread = std::thread(&work_stealing_pool::run, this, i);
+        }
+    }
+    catch (...) {
+        stopWorkers(); // Running workers would otherwise terminate the program once destroyed
+        throw;
+    }
+}
+
+inline work_stealing_pool::~work_stealing_pool() {
+    stopWorkers();
+}
+
+inline void work_stealing_pool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+inline std::size_t work_stealing_pool::currentWorker() const {
+    return currentPool_ == this ? currentIndex_ : workers_.size();
+}
+
+inline bool work_stealing_pool::take(std::size_t self, std::function<void()>& task) {
+    {
+        Worker& own = *workers_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal, starting after self so thieves spread over the victims
+    for (std::size_t i = 1; i < workers_.size(); i++) {
+        Worker& victim = *workers_[(self + i) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void work_stealing_pool::run(std::size_t self) {
+    currentPool_ = this;
+    currentIndex_ = self;
+
+    std::function<void()> task;
+    for (;;) {
+        if (!take(self, task)) {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            wake_.wait(lock, [&] { return stop_ || queued_.load() > 0; });
+            if (stop_ && queued_.load() <= 0) {
+                return;
+            }
+            continue;
+        }
+        queued_--;
+
+        try {
+            task();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+        task = nullptr;
+
+        if (--unfinished_ == 0) {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            idle_.notify_all();
+        }
+    }
+}
+
+inline void work_stealing_pool::submit(std::function<void()> task) {
+    std::size_t target = currentWorker();
+    if (target == workers_.size()) {
+        target = next_++ % workers_.size();
+    }
+
+    unfinished_++;
+    {
+        Worker& worker = *workers_[target];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    {
+        // Raise queued_ under the lock so a worker about to sleep sees it
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        queued_++;
+    }
+    wake_.notify_one();
+}
+
+inline void work_stealing_pool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    idle_.wait(lock, [&] { return unfinished_.load() == 0; });
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace
+
+#endif // WILDERFIELD_WORK_STEALING_POOL_HPP
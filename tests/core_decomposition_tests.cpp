@@ -0,0 +1,89 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/core_decomposition.hpp"
+#include "wilderfield/algorithms/csr_graph.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using wilderfield::algorithms::csr_graph;
+
+TEST_CASE("CsrGraph construction is tested", "[core_decomposition]") {
+
+    SECTION("Checking edge lists keep per node order") {
+        csr_graph graph(4, {{2, 1}, {0, 3}, {2, 0}, {0, 1}});
+        REQUIRE(graph.node_count() == 4);
+        REQUIRE(graph.edge_count() == 4);
+        REQUIRE(std::vector<csr_graph::node_type>(graph.neighbors(0).begin(), graph.neighbors(0).end()) == std::vector<csr_graph::node_type>{3, 1});
+        REQUIRE(std::vector<csr_graph::node_type>(graph.neighbors(2).begin(), graph.neighbors(2).end()) == std::vector<csr_graph::node_type>{1, 0});
+        REQUIRE(graph.degree(1) == 0);
+    }
+
+    SECTION("Checking undirected edges are stored both ways") {
+        csr_graph graph(3, {{0, 1}, {1, 2}}, true);
+        REQUIRE(graph.edge_count() == 4);
+        REQUIRE(graph.degree(1) == 2);
+    }
+
+    SECTION("Checking invalid input is rejected") {
+        using edges = std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>>;
+        REQUIRE_THROWS_AS(csr_graph(2, edges{{0, 2}}), std::invalid_argument);
+        REQUIRE_THROWS_AS(csr_graph({0, 2}, {0}), std::invalid_argument);
+        REQUIRE_THROWS_AS(csr_graph({0, 1}, {1}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("CoreDecomposition is tested", "[core_decomposition]") {
+
+    SECTION("Checking a clique with a tail") {
+        // K4 on 0..3, then a path 3-4-5
+        csr_graph graph(6, {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}, {3, 4}, {4, 5}}, true);
+        auto result = wilderfield::algorithms::core_decomposition(graph);
+        REQUIRE(result.core == std::vector<std::size_t>{3, 3, 3, 3, 1, 1});
+        REQUIRE(result.degeneracy == 3);
+        REQUIRE(result.order.size() == 6);
+        REQUIRE(result.order.front() == 5);
+    }
+
+    SECTION("Checking against naive peeling") {
+        const csr_graph::node_type n = 300;
+        std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>> edges;
+        unsigned seed = 11;
+        for (int i = 0; i < 1500; i++) {
+            seed = seed * 1103515245u + 12345u;
+            auto u = (seed >> 8) % n;
+            seed = seed * 1103515245u + 12345u;
+            auto v = (seed >> 8) % (u + 1); // Skewed towards low ids
+            if (u != v) {
+                edges.emplace_back(u, v);
+            }
+        }
+        csr_graph graph(n, edges, true);
+        auto result = wilderfield::algorithms::core_decomposition(graph);
+
+        // The k-core is what is left after repeatedly deleting nodes of degree below k
+        for (std::size_t k = 1; k <= result.degeneracy + 1; k++) {
+            std::vector<bool> alive(n, true);
+            bool changed = true;
+            while (changed) {
+                changed = false;
+                for (csr_graph::node_type u = 0; u < n; u++) {
+                    if (!alive[u]) {
+                        continue;
+                    }
+                    std::size_t degree = 0;
+                    for (auto v : graph.neighbors(u)) {
+                        degree += alive[v];
+                    }
+                    if (degree < k) {
+                        alive[u] = false;
+                        changed = true;
+                    }
+                }
+            }
+            for (csr_graph::node_type u = 0; u < n; u++) {
+                REQUIRE(alive[u] == (result.core[u] >= k));
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/dijkstra.hpp"
+#include "wilderfield/algorithms/weighted_csr_graph.hpp"
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using wilderfield::algorithms::weighted_csr_graph;
+
+TEST_CASE("WeightedCsrGraph construction is tested", "[dijkstra]") {
+
+    SECTION("Checking weights follow their edges") {
+        weighted_csr_graph<int> graph(3, {{2, 0, 5}, {0, 1, 7}, {2, 1, 6}, {0, 2, 8}});
+        REQUIRE(std::vector<unsigned>(graph.neighbors(2).begin(), graph.neighbors(2).end()) == std::vector<unsigned>{0, 1});
+        REQUIRE(std::vector<int>(graph.weights(2).begin(), graph.weights(2).end()) == std::vector<int>{5, 6});
+        REQUIRE(std::vector<int>(graph.weights(0).begin(), graph.weights(0).end()) == std::vector<int>{7, 8});
+    }
+
+    SECTION("Checking undirected edges carry their weight both ways") {
+        weighted_csr_graph<double> graph(2, {{0, 1, 2.5}}, true);
+        REQUIRE(graph.edge_count() == 2);
+        REQUIRE(*graph.weights(1).begin() == 2.5);
+    }
+
+    SECTION("Checking mismatched weights are rejected") {
+        wilderfield::algorithms::csr_graph plain(2, {{0, 1}});
+        REQUIRE_THROWS_AS(weighted_csr_graph<int>(plain, {1, 2}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Dijkstra is tested", "[dijkstra]") {
+
+    SECTION("Checking distances and parents on a small graph") {
+        weighted_csr_graph<int> graph(5, {{0, 1, 4}, {0, 2, 1}, {2, 1, 2}, {1, 3, 1}, {2, 3, 5}});
+        auto result = wilderfield::algorithms::dijkstra(graph, 0);
+        REQUIRE(result.distance[0] == 0);
+        REQUIRE(result.distance[1] == 3);
+        REQUIRE(result.distance[2] == 1);
+        REQUIRE(result.distance[3] == 4);
+        REQUIRE(result.parent[3] == 1);
+        REQUIRE(result.parent[1] == 2);
+        REQUIRE(result.parent[0] == result.no_parent);
+        REQUIRE(!result.reachable(4));
+        REQUIRE(result.distance[4] == std::numeric_limits<int>::max());
+    }
+
+    SECTION("Checking against a lazy deletion heap on a random graph") {
+        const unsigned n = 3000;
+        std::vector<weighted_csr_graph<long>::edge_type> edges;
+        unsigned seed = 5;
+        auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for (int i = 0; i < 20000; i++) {
+            edges.emplace_back(next() % n, next() % n, static_cast<long>(next() % 1000));
+        }
+        weighted_csr_graph<long> graph(n, edges);
+        auto result = wilderfield::algorithms::dijkstra(graph, 0);
+
+        std::vector<long> expected(n, std::numeric_limits<long>::max());
+        std::priority_queue<std::pair<long, unsigned>, std::vector<std::pair<long, unsigned>>, std::greater<>> heap;
+        expected[0] = 0;
+        heap.emplace(0, 0);
+        while (!heap.empty()) {
+            auto [d, u] = heap.top();
+            heap.pop();
+            if (d != expected[u]) {
+                continue;
+            }
+            const auto targets = graph.neighbors(u);
+            const auto weights = graph.weights(u);
+            for (size_t e = 0; e < targets.size(); e++) {
+                const unsigned v = targets.begin()[e];
+                if (d + weights.begin()[e] < expected[v]) {
+                    expected[v] = d + weights.begin()[e];
+                    heap.emplace(expected[v], v);
+                }
+            }
+        }
+        REQUIRE(result.distance == expected);
+
+        // Each parent edge closes the gap between the two distances
+        for (unsigned v = 1; v < n; v++) {
+            if (result.reachable(v)) {
+                const unsigned u = result.parent[v];
+                REQUIRE(result.distance[u] <= result.distance[v]);
+            }
+        }
+    }
+
+    SECTION("Checking invalid input is rejected") {
+        weighted_csr_graph<int> negative(2, {{0, 1, -1}});
+        REQUIRE_THROWS_AS(wilderfield::algorithms::dijkstra(negative, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(wilderfield::algorithms::dijkstra(negative, 2), std::invalid_argument);
+    }
+}
@@ -0,0 +1,74 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/algorithms/dsatur.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using wilderfield::algorithms::csr_graph;
+
+static bool properlyColored(const csr_graph& graph, const wilderfield::algorithms::dsatur_result& result) {
+    for (csr_graph::node_type u = 0; u < graph.node_count(); u++) {
+        if (result.color[u] >= result.color_count) {
+            return false;
+        }
+        for (auto v : graph.neighbors(u)) {
+            if (v != u && result.color[u] == result.color[v]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+TEST_CASE("DsaturColoring is tested", "[dsatur]") {
+
+    SECTION("Checking cycles and cliques") {
+        csr_graph even(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 0}}, true);
+        auto evenResult = wilderfield::algorithms::dsatur_coloring(even);
+        REQUIRE(properlyColored(even, evenResult));
+        REQUIRE(evenResult.color_count == 2);
+
+        csr_graph odd(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}}, true);
+        auto oddResult = wilderfield::algorithms::dsatur_coloring(odd);
+        REQUIRE(properlyColored(odd, oddResult));
+        REQUIRE(oddResult.color_count == 3);
+
+        std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>> edges;
+        for (csr_graph::node_type u = 0; u < 6; u++) {
+            for (csr_graph::node_type v = u + 1; v < 6; v++) {
+                edges.emplace_back(u, v);
+            }
+        }
+        csr_graph clique(6, edges, true);
+        REQUIRE(wilderfield::algorithms::dsatur_coloring(clique).color_count == 6);
+    }
+
+    SECTION("Checking bipartite graphs get two colors") {
+        // DSatur is exact on bipartite graphs
+        std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>> edges;
+        unsigned seed = 13;
+        auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for (int i = 0; i < 3000; i++) {
+            edges.emplace_back(2 * (next() % 500), 2 * (next() % 500) + 1);
+        }
+        csr_graph graph(1000, edges, true);
+        auto result = wilderfield::algorithms::dsatur_coloring(graph);
+        REQUIRE(properlyColored(graph, result));
+        REQUIRE(result.color_count == 2);
+    }
+
+    SECTION("Checking random graphs are properly colored") {
+        std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>> edges;
+        unsigned seed = 17;
+        auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for (int i = 0; i < 20000; i++) {
+            edges.emplace_back(next() % 2000, next() % 2000); // Includes a few self loops
+        }
+        csr_graph graph(2000, edges, true);
+        auto result = wilderfield::algorithms::dsatur_coloring(graph);
+        REQUIRE(properlyColored(graph, result));
+        REQUIRE(*std::max_element(result.color.begin(), result.color.end()) + 1 == result.color_count);
+    }
+}
@@ -0,0 +1,129 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/fixed_priority_map.hpp"
+
+#include <array>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+// Kahn's algorithm over the test graph used by the priority_map tests,
+// evaluated entirely at compile time.
+constexpr std::array<std::size_t, 6> constexprTopSort() {
+
+    constexpr std::size_t edges[][2] = {{0,1},{0,3},{2,0},{2,4},{3,1},{4,3},{4,5},{5,1}};
+
+    wilderfield::fixed_priority_map<int, 6, std::less<int>> pmap;
+
+    // Initialize pmap to have all nodes with indegree 0
+    for (std::size_t u = 0; u < 6; u++) {
+        pmap[u] = 0;
+    }
+
+    // Calculate indegrees for each node
+    for (const auto& edge : edges) {
+        ++pmap[edge[1]];
+    }
+
+    std::array<std::size_t, 6> order{};
+    std::size_t n = 0;
+    while (!pmap.empty()) {
+        auto [u, minVal] = pmap.top(); pmap.pop();
+        if (minVal != 0) {
+            throw std::logic_error("Graph has a cycle.");
+        }
+        order[n++] = u;
+        for (const auto& edge : edges) {
+            if (edge[0] == u) {
+                --pmap[edge[1]];
+            }
+        }
+    }
+    return order;
+}
+
+constexpr int constexprMaxAfterUpdates() {
+    wilderfield::fixed_priority_map<int, 4> pmap;
+    ++pmap[1];
+    ++pmap[1];
+    pmap[2] = 5;
+    --pmap[2];
+    pmap[3] = -1;
+    pmap.erase(2);
+    return pmap.top().second;
+}
+
+} // namespace
+
+TEST_CASE("FixedPriorityMap operations are tested", "[fixed_priority_map]") {
+
+    wilderfield::fixed_priority_map<int, 16> pmap;
+
+    SECTION("Checking empty(), size() and erase()") {
+        REQUIRE(pmap.empty());
+        ++pmap[7];
+        REQUIRE(pmap.size() == 1);
+        REQUIRE(pmap.erase(7) == 1);
+        REQUIRE(pmap.erase(7) == 0);
+        REQUIRE(pmap.empty());
+    }
+
+    SECTION("Checking count() and capacity") {
+        ++pmap[7];
+        REQUIRE(pmap.count(7) == 1);
+        REQUIRE(pmap.count(8) == 0);
+        REQUIRE(pmap.count(16) == 0);
+        REQUIRE_THROWS_AS(pmap[16], std::out_of_range);
+    }
+
+    SECTION("Checking top() and pop()") {
+        ++pmap[7];
+        ++pmap[7];
+        ++pmap[7];
+        ++pmap[11];
+        ++pmap[11];
+        pmap[3] = -4;
+        {
+            auto [maxKey, maxVal] = pmap.top();
+            REQUIRE(maxKey == 7);
+            REQUIRE(maxVal == 3);
+            pmap.pop();
+        }
+        {
+            auto [maxKey, maxVal] = pmap.top();
+            REQUIRE(maxKey == 11);
+            REQUIRE(maxVal == 2);
+            pmap.pop();
+        }
+        {
+            auto [maxKey, maxVal] = pmap.top();
+            REQUIRE(maxKey == 3);
+            REQUIRE(maxVal == -4);
+            pmap.pop();
+        }
+        REQUIRE(pmap.empty());
+        REQUIRE_THROWS_AS(pmap.top(), std::out_of_range);
+        REQUIRE_THROWS_AS(pmap.pop(), std::out_of_range);
+    }
+
+    SECTION("Every key at a distinct value") {
+        for (std::size_t i = 0; i < 16; i++) {
+            pmap[i] = static_cast<int>(i);
+        }
+        pmap[0] = 100;
+        pmap[15] = -100;
+        REQUIRE(pmap.top().first == 0);
+        for (std::size_t i = 14; i > 0; i--) {
+            pmap.pop();
+            REQUIRE(pmap.top().first == i);
+        }
+    }
+
+    SECTION("Checking constant evaluation") {
+        constexpr auto order = constexprTopSort();
+        static_assert(order[0] == 2, "Node 2 is the only source.");
+        static_assert(order[5] == 1, "Node 1 is the only sink.");
+        static_assert(constexprMaxAfterUpdates() == 2, "Key 1 holds the largest value.");
+        REQUIRE(order[0] == 2);
+    }
+}
@@ -0,0 +1,126 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/frozen_priority_map.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Sends keys a multiple of 1000 apart to the same value
+struct mod_1000_hash {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key % 1000); }
+};
+
+} // namespace
+
+TEST_CASE("RankSelectBitvector operations are tested", "[frozen_priority_map]") {
+
+    std::vector<bool> bits(2000);
+    for (size_t i = 0; i < bits.size(); i++) {
+        bits[i] = i % 3 == 0 || (i > 700 && i < 1300 && i % 7 == 0);
+    }
+    wilderfield::rank_select_bitvector bv(bits);
+
+    size_t ones = 0;
+    for (size_t i = 0; i < bits.size(); i++) {
+        REQUIRE(bv.rank(i) == ones);
+        REQUIRE(bv[i] == bits[i]);
+        if (bits[i]) {
+            REQUIRE(bv.select(ones) == i);
+            ones++;
+        }
+    }
+    REQUIRE(bv.rank(bits.size()) == ones);
+    REQUIRE(bv.ones() == ones);
+    REQUIRE(bv.select(ones) == bits.size());
+    REQUIRE_THROWS_AS(bv.select(ones + 1), std::out_of_range);
+}
+
+TEST_CASE("FrozenPriorityMap operations are tested", "[frozen_priority_map]") {
+
+    wilderfield::priority_map<int, int> pmap;
+    for (int i = 0; i < 1000; i++) {
+        pmap[i] = i % 10;
+    }
+    auto frozen = wilderfield::freeze(pmap);
+
+    SECTION("Checking lookups match the live map") {
+        REQUIRE(frozen.size() == 1000);
+        for (int i = 0; i < 1000; i++) {
+            REQUIRE(frozen.value(i) == pmap.at(i));
+            REQUIRE(frozen.at_rank(*frozen.rank(i)) == std::make_pair(i, i % 10));
+        }
+        REQUIRE(!frozen.contains(1000));
+        REQUIRE(!frozen.value(1000));
+        REQUIRE(!frozen.rank(-1));
+        REQUIRE_THROWS_AS(frozen.at_rank(1000), std::out_of_range);
+    }
+
+    SECTION("Checking ranks follow priority order") {
+        REQUIRE(frozen.top().second == 9);
+        for (size_t pos = 1; pos < frozen.size(); pos++) {
+            REQUIRE(frozen.at_rank(pos - 1).second >= frozen.at_rank(pos).second);
+        }
+        auto top = frozen.top_k(150);
+        REQUIRE(top.size() == 150);
+        REQUIRE(top[99].second == 9);
+        REQUIRE(top[100].second == 8);
+        REQUIRE(frozen.top_k(5000).size() == 1000);
+    }
+
+    SECTION("Checking range queries") {
+        auto mid = frozen.range(3, 5);
+        REQUIRE(mid.size() == 300);
+        REQUIRE(mid.front().second == 5);
+        REQUIRE(mid.back().second == 3);
+        REQUIRE(frozen.range(5, 3).size() == 300);
+        REQUIRE(frozen.range(10, 20).empty());
+        REQUIRE(frozen.range(-5, 0).size() == 100);
+    }
+
+    SECTION("Checking the frozen form is smaller") {
+        REQUIRE(frozen.memory_bytes() < 1000 * 3 * sizeof(void*));
+
+        // The positions table holds an index per key, not a second copy of the keys
+        REQUIRE(frozen.memory_bytes() < 1000 * (sizeof(int) + sizeof(std::uint32_t) + 4) + 1024);
+    }
+}
+
+TEST_CASE("FrozenPriorityMap from unsorted pairs", "[frozen_priority_map]") {
+
+    std::vector<std::pair<int, double>> items = {{1, 2.5}, {2, -1.0}, {3, 7.0}, {4, 2.5}};
+    wilderfield::frozen_priority_map<int, double, std::less<double>> frozen(items.begin(), items.end());
+    REQUIRE(frozen.top() == std::make_pair(2, -1.0));
+    REQUIRE(frozen.rank(3) == 3u);
+    REQUIRE(frozen.range(2.0, 3.0).size() == 2);
+
+    items.emplace_back(1, 0.0);
+    using frozen_type = wilderfield::frozen_priority_map<int, double>;
+    REQUIRE_THROWS_AS(frozen_type(items.begin(), items.end()), std::invalid_argument);
+}
+
+TEST_CASE("FrozenPriorityMap with colliding Hash values", "[frozen_priority_map]") {
+
+    wilderfield::priority_map<int, int, std::greater<int>, mod_1000_hash> pmap;
+    pmap[1] = 3;
+    pmap[1001] = 7;
+    pmap[2001] = 5;
+    pmap[5] = 1;
+    auto frozen = wilderfield::freeze(pmap);
+
+    REQUIRE(frozen.size() == 4);
+    REQUIRE(frozen.top() == std::make_pair(1001, 7));
+    REQUIRE(frozen.value(1) == 3);
+    REQUIRE(frozen.value(1001) == 7);
+    REQUIRE(frozen.value(2001) == 5);
+    REQUIRE(frozen.rank(5) == 3u);
+    REQUIRE(!frozen.contains(3001));
+
+    std::vector<std::pair<int, int>> items = {{1, 1}, {1001, 2}, {1001, 3}};
+    using frozen_type = wilderfield::frozen_priority_map<int, int, std::greater<int>, mod_1000_hash>;
+    REQUIRE_THROWS_AS(frozen_type(items.begin(), items.end()), std::invalid_argument);
+}
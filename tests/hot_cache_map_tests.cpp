@@ -0,0 +1,153 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/hot_cache_map.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+TEST_CASE("HotCacheMap operations are tested", "[hot_cache_map]") {
+
+    wilderfield::hot_cache_map<int, int> map(16);
+
+    SECTION("Checking cache hits and misses") {
+        REQUIRE(map.cache_slots() == 16);
+        map[7] = 1;
+        REQUIRE(map.misses() == 1);
+        for (int i = 0; i < 10; i++) {
+            ++map[7];
+        }
+        REQUIRE(map.hits() == 10);
+        REQUIRE(map.at(7) == 11);
+        REQUIRE(map.hit_rate() > 0.9);
+        map.reset_stats();
+        REQUIRE(map.hits() == 0);
+        REQUIRE(map.hit_rate() == 0.0);
+        REQUIRE(!map.try_emplace(7).second);
+        REQUIRE(map.try_emplace(8).second);
+        REQUIRE(map.hits() == 1);
+        REQUIRE(map.misses() == 1);
+    }
+
+    SECTION("Checking erase() clears the cached entry") {
+        map[7] = 1;
+        REQUIRE(map.find(7) != map.end());
+        REQUIRE(map.erase(7) == 1);
+        REQUIRE(map.find(7) == map.end());
+        REQUIRE(map.count(7) == 0);
+        REQUIRE(map.erase(7) == 0);
+        REQUIRE(map.empty());
+    }
+
+    SECTION("Checking colliding keys") {
+        for (int i = 0; i < 1000; i++) {
+            map[i] = i;
+        }
+        REQUIRE(map.size() == 1000);
+        for (int i = 0; i < 1000; i++) {
+            REQUIRE(map.find(i)->second == i);
+        }
+    }
+
+    SECTION("Checking copies start cold") {
+        map[7] = 3;
+        REQUIRE(map.find(7) != map.end());
+        auto copy = map;
+        copy.erase(7);
+        REQUIRE(map.at(7) == 3);
+        REQUIRE(copy.count(7) == 0);
+    }
+
+    SECTION("Checking moved-from maps stay usable") {
+        map[7] = 3;
+        REQUIRE(map.find(7) != map.end());
+        auto moved = std::move(map);
+        REQUIRE(moved.at(7) == 3);
+        REQUIRE(map.cache_slots() == 16);
+        REQUIRE(map.find(7) == map.end());
+        map[8] = 4;
+        REQUIRE(map.at(8) == 4);
+        REQUIRE(map.erase(8) == 1);
+
+        wilderfield::hot_cache_map<int, int> assigned(4);
+        assigned = std::move(moved);
+        REQUIRE(assigned.at(7) == 3);
+        REQUIRE(moved.count(7) == 0);
+        moved[7] = 1;
+        REQUIRE(moved.at(7) == 1);
+    }
+
+    SECTION("Checking const lookups read the cache without filling it") {
+        map[7] = 3;
+        const auto cold = map;
+        REQUIRE(cold.find(7)->second == 3);
+        REQUIRE(cold.find(7)->second == 3);
+        REQUIRE(cold.find(8) == cold.end());
+        REQUIRE(cold.hits() == 0);
+        REQUIRE(cold.misses() == 3);
+
+        map.reset_stats();
+        const auto& warm = map;
+        REQUIRE(warm.find(7)->second == 3);
+        REQUIRE(warm.hits() == 1);
+    }
+
+    SECTION("Checking concurrent const lookups") {
+        for (int i = 0; i < 100; i++) {
+            map[i] = i;
+        }
+        map.reset_stats();
+        const auto& shared = map;
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; t++) {
+            readers.emplace_back([&shared] {
+                for (int round = 0; round < 100; round++) {
+                    for (int i = 0; i < 100; i++) {
+                        if (shared.find(i)->second != i) {
+                            throw std::logic_error("Wrong entry found.");
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        REQUIRE(map.hits() + map.misses() == 40000);
+    }
+}
+
+TEST_CASE("PriorityMap with a hot key cache index", "[hot_cache_map]") {
+
+    wilderfield::priority_map<std::string, int, std::greater<int>, std::hash<std::string>, wilderfield::hot_cache_map> pmap;
+
+    std::string s = "supercalifragilisticexpialidocious";
+    for (auto c : s) {
+        ++pmap[std::string(1, c)];
+    }
+    auto [maxKey, maxVal] = pmap.top();
+    REQUIRE(maxKey == "i");
+    REQUIRE(maxVal == 7);
+    REQUIRE(pmap.key_index().hits() > 0);
+
+    while (!pmap.empty()) {
+        pmap.pop();
+    }
+    REQUIRE(pmap.key_index().empty());
+}
+
+TEST_CASE("PriorityMap with a hot key cache index after a move", "[hot_cache_map]") {
+
+    wilderfield::priority_map<int, int, std::greater<int>, std::hash<int>, wilderfield::hot_cache_map> a;
+    ++a[1];
+    ++a[2];
+    auto b = std::move(a);
+    REQUIRE(b.size() == 2);
+
+    ++a[2];
+    REQUIRE(a.size() == 1);
+    REQUIRE(a.top() == std::make_pair(2, 1));
+}
@@ -0,0 +1,73 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/huffman.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+TEST_CASE("HuffmanCodeLengths is tested", "[huffman]") {
+
+    SECTION("Checking the textbook example") {
+        std::string text = std::string(45, 'a') + std::string(13, 'b') + std::string(12, 'c') +
+                           std::string(16, 'd') + std::string(9, 'e') + std::string(5, 'f');
+        auto result = wilderfield::algorithms::huffman_code_lengths(text.begin(), text.end());
+        REQUIRE(result.symbols == std::vector<char>{'a', 'd', 'b', 'c', 'e', 'f'});
+        REQUIRE(result.counts == std::vector<std::size_t>{45, 16, 13, 12, 9, 5});
+        REQUIRE(result.lengths == std::vector<std::size_t>{1, 3, 3, 3, 4, 4});
+    }
+
+    SECTION("Checking empty and single symbol streams") {
+        std::string empty;
+        auto none = wilderfield::algorithms::huffman_code_lengths(empty.begin(), empty.end());
+        REQUIRE(none.symbols.empty());
+        REQUIRE(none.lengths.empty());
+
+        std::string same(7, 'x');
+        auto one = wilderfield::algorithms::huffman_code_lengths(same.begin(), same.end());
+        REQUIRE(one.symbols == std::vector<char>{'x'});
+        REQUIRE(one.counts == std::vector<std::size_t>{7});
+        REQUIRE(one.lengths == std::vector<std::size_t>{1});
+    }
+
+    SECTION("Checking cost and completeness against a heap on random ids") {
+        std::vector<std::uint32_t> stream;
+        unsigned seed = 5;
+        auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for (int i = 0; i < 20000; i++) {
+            stream.push_back(next() % (1 + next() % 300)); // Skewed towards small ids
+        }
+        auto result = wilderfield::algorithms::huffman_code_lengths(stream.begin(), stream.end());
+
+        std::size_t total = 0;
+        std::size_t bits = 0;
+        double kraft = 0;
+        std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t>> heap;
+        for (std::size_t i = 0; i < result.symbols.size(); i++) {
+            total += result.counts[i];
+            bits += result.counts[i] * result.lengths[i];
+            kraft += 1.0 / static_cast<double>(std::size_t(1) << result.lengths[i]);
+            heap.push(result.counts[i]);
+            if (i > 0) {
+                REQUIRE(result.counts[i - 1] >= result.counts[i]);
+                REQUIRE(result.lengths[i - 1] <= result.lengths[i]);
+            }
+        }
+        REQUIRE(total == stream.size());
+        REQUIRE(kraft == Approx(1.0));
+
+        // An optimal code costs the sum of all merged weights
+        std::size_t optimal = 0;
+        while (heap.size() > 1) {
+            const std::size_t a = heap.top();
+            heap.pop();
+            const std::size_t b = heap.top();
+            heap.pop();
+            optimal += a + b;
+            heap.push(a + b);
+        }
+        REQUIRE(bits == optimal);
+    }
+}
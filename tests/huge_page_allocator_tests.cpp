@@ -0,0 +1,122 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/huge_page_allocator.hpp"
+#include "wilderfield/incremental_hash_map.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("HugePageArena operations are tested", "[huge_page_allocator]") {
+
+    wilderfield::huge_page_arena arena(wilderfield::huge_page_arena::huge_page_size);
+
+    SECTION("Checking alignment and reuse of freed nodes") {
+        std::set<void*> seen;
+        for (std::size_t bytes : {1, 16, 24, 100, 512, 513, 4096, 70000}) {
+            void* ptr = arena.allocate(bytes);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % 16 == 0);
+            REQUIRE(seen.insert(ptr).second);
+            std::memset(ptr, 0xab, bytes);
+        }
+        REQUIRE(arena.reserved_bytes() == wilderfield::huge_page_arena::huge_page_size);
+
+        void* node = arena.allocate(40);
+        arena.deallocate(node, 40);
+        REQUIRE(arena.allocate(48) == node);
+    }
+
+    SECTION("Checking oversized requests get their own mapping") {
+        const std::size_t bytes = 3 * wilderfield::huge_page_arena::huge_page_size;
+        void* ptr = arena.allocate(bytes);
+        std::memset(ptr, 0, bytes);
+        REQUIRE(arena.reserved_bytes() == bytes);
+        arena.deallocate(ptr, bytes);
+        REQUIRE(arena.reserved_bytes() == 0);
+    }
+
+    SECTION("Checking chunks are added when one fills up") {
+        for (int i = 0; i < 5000; i++) {
+            arena.allocate(512);
+        }
+        REQUIRE(arena.reserved_bytes() == 2 * wilderfield::huge_page_arena::huge_page_size);
+    }
+}
+
+TEST_CASE("HugePageAllocator across threads", "[huge_page_allocator]") {
+
+    // Each thread allocates through its own cache and frees nodes the next thread allocated
+    constexpr int threads = 4;
+    constexpr int nodes = 3000;
+    wilderfield::huge_page_allocator<std::uint64_t> alloc;
+    std::vector<std::vector<std::uint64_t*>> allocated(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < nodes; i++) {
+                std::uint64_t* node = alloc.allocate(2);
+                node[0] = static_cast<std::uint64_t>(t);
+                node[1] = static_cast<std::uint64_t>(i);
+                allocated[t].push_back(node);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::set<std::uint64_t*> seen;
+    for (int t = 0; t < threads; t++) {
+        for (int i = 0; i < nodes; i++) {
+            REQUIRE(allocated[t][i][0] == static_cast<std::uint64_t>(t));
+            REQUIRE(allocated[t][i][1] == static_cast<std::uint64_t>(i));
+            REQUIRE(seen.insert(allocated[t][i]).second);
+        }
+    }
+
+    workers.clear();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (auto* node : allocated[(t + 1) % threads]) {
+                alloc.deallocate(node, 2);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Nodes the exited threads freed are back in the arena, so this thread maps nothing new
+    const std::size_t reserved = wilderfield::huge_page_arena::global().reserved_bytes();
+    std::vector<std::uint64_t*> reused;
+    for (int i = 0; i < nodes; i++) {
+        reused.push_back(alloc.allocate(2));
+    }
+    REQUIRE(wilderfield::huge_page_arena::global().reserved_bytes() == reserved);
+    for (auto* node : reused) {
+        alloc.deallocate(node, 2);
+    }
+}
+
+TEST_CASE("PriorityMap with huge page node storage", "[huge_page_allocator]") {
+
+    wilderfield::priority_map<int, int, std::greater<int>, std::hash<int>,
+        wilderfield::incremental_hash_map, wilderfield::huge_page_allocator<int>> pmap;
+
+    for (int i = 0; i < 20000; i++) {
+        ++pmap[i % 5000];
+    }
+    REQUIRE(pmap.size() == 5000);
+    REQUIRE(pmap.top().second == 4);
+    for (int i = 0; i < 5000; i += 2) {
+        REQUIRE(pmap.erase(i) == 1);
+    }
+    --pmap[1];
+    REQUIRE(pmap.size() == 2500);
+    REQUIRE(pmap.top().second == 4);
+    REQUIRE(pmap.get(1) == 3);
+    REQUIRE(wilderfield::huge_page_arena::global().reserved_bytes() > 0);
+}
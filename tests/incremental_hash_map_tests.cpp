@@ -0,0 +1,98 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/incremental_hash_map.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <functional>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+TEST_CASE("IncrementalHashMap operations are tested", "[incremental_hash_map]") {
+
+    wilderfield::incremental_hash_map<int, int> map;
+
+    SECTION("Checking growth keeps every key reachable") {
+        bool sawRehash = false;
+        for (int i = 0; i < 10000; i++) {
+            map[i] = i;
+            sawRehash |= map.rehashing();
+            REQUIRE(map.find(i / 2)->second == i / 2);
+        }
+        REQUIRE(sawRehash);
+        REQUIRE(map.size() == 10000);
+        REQUIRE(map.bucket_count() >= 10000);
+        for (int i = 0; i < 10000; i++) {
+            REQUIRE(map.at(i) == i);
+        }
+        REQUIRE(map.count(10000) == 0);
+        REQUIRE_THROWS_AS(map.at(10000), std::out_of_range);
+        REQUIRE(!map.try_emplace(5).second);
+        REQUIRE(map.try_emplace(10000).second);
+        REQUIRE(map.try_emplace(10000).first == map.find(10000));
+    }
+
+    SECTION("Checking against std::unordered_map") {
+        std::unordered_map<int, int> reference;
+        unsigned seed = 7;
+        for (int i = 0; i < 50000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            int key = (seed >> 8) % 5000;
+            if ((seed >> 4) % 4 == 0) {
+                REQUIRE(map.erase(key) == reference.erase(key));
+            }
+            else {
+                ++map[key];
+                ++reference[key];
+            }
+            REQUIRE(map.size() == reference.size());
+        }
+        for (auto& [key, val] : reference) {
+            REQUIRE(map.at(key) == val);
+        }
+    }
+
+    SECTION("Checking move") {
+        map[1] = 2;
+        auto moved = std::move(map);
+        REQUIRE(moved.at(1) == 2);
+        map = std::move(moved);
+        REQUIRE(map.at(1) == 2);
+    }
+}
+
+TEST_CASE("PriorityMap with an incremental rehashing index", "[incremental_hash_map]") {
+
+    wilderfield::priority_map<std::string, int, std::greater<int>, std::hash<std::string>, wilderfield::incremental_hash_map> pmap;
+
+    for (int i = 0; i < 2000; i++) {
+        ++pmap[std::to_string(i % 700)];
+    }
+    REQUIRE(pmap.size() == 700);
+    auto [maxKey, maxVal] = pmap.top();
+    REQUIRE(std::stoi(maxKey) < 600);
+    REQUIRE(maxVal == 3);
+    REQUIRE(pmap.erase("5") == 1);
+    REQUIRE(pmap.size() == 699);
+}
+
+TEST_CASE("PriorityMap growing at one value with an incremental index", "[incremental_hash_map]") {
+
+    // Every key joins the bucket of 0 while the index grows underneath it
+    wilderfield::priority_map<int, int, std::less<int>, std::hash<int>, wilderfield::incremental_hash_map> pmap;
+    for (int i = 0; i < 20000; i++) {
+        pmap[i];
+        REQUIRE(pmap.at(i / 2) == 0);
+    }
+    REQUIRE(pmap.key_index().bucket_count() >= 20000);
+    for (int i = 0; i < 20000; i += 2) {
+        ++pmap[i];
+    }
+    REQUIRE(pmap.top().second == 0);
+    std::vector<int> zeros;
+    pmap.pop_top_bucket(std::back_inserter(zeros));
+    REQUIRE(zeros.size() == 10000);
+    REQUIRE(pmap.size() == 10000);
+    REQUIRE(pmap.top().second == 1);
+}
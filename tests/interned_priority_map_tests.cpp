@@ -0,0 +1,98 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/interned_priority_map.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+TEST_CASE("StringInterner operations are tested", "[string_interner]") {
+
+    wilderfield::string_interner interner;
+
+    SECTION("Checking ids are dense and stable") {
+        REQUIRE(interner.intern("alpha") == 0);
+        REQUIRE(interner.intern("beta") == 1);
+        REQUIRE(interner.intern("alpha") == 0);
+        REQUIRE(interner.size() == 2);
+        REQUIRE(interner.bytes() == 9);
+        REQUIRE(interner[1] == "beta");
+        REQUIRE(interner.find("beta") == 1u);
+        REQUIRE(!interner.find("gamma"));
+    }
+
+    SECTION("Checking views survive arena growth") {
+        std::string big(100000, 'x');
+        auto bigId = interner.intern(big);
+        auto first = interner[interner.intern("first")];
+        for (int i = 0; i < 20000; i++) {
+            interner.intern("key-" + std::to_string(i));
+        }
+        REQUIRE(first == "first");
+        REQUIRE(interner[bigId] == big);
+        REQUIRE(interner.find("key-19999"));
+        REQUIRE(interner.intern("") == interner.intern(std::string()));
+    }
+
+    SECTION("Checking moved-from interners start over") {
+        interner.intern("hello");
+        {
+            wilderfield::string_interner moved(std::move(interner));
+            REQUIRE(moved[0] == "hello");
+        }
+        REQUIRE(interner.size() == 0);
+        REQUIRE(interner.bytes() == 0);
+        REQUIRE(interner.intern("world") == 0);
+        REQUIRE(interner[0] == "world");
+
+        wilderfield::string_interner assigned;
+        assigned.intern("x");
+        assigned = std::move(interner);
+        REQUIRE(interner.intern("again") == 0);
+        REQUIRE(assigned[0] == "world");
+        REQUIRE(interner[0] == "again");
+    }
+}
+
+TEST_CASE("InternedPriorityMap operations are tested", "[interned_priority_map]") {
+
+    wilderfield::interned_priority_map<int> pmap;
+
+    SECTION("Checking counts by string_view") {
+        std::unordered_map<std::string, int> umap;
+        for (auto url : {"https://a.example/x", "https://b.example/y", "https://a.example/x",
+                         "https://c.example/z", "https://a.example/x", "https://b.example/y"}) {
+            ++pmap[url];
+            ++umap[url];
+        }
+        REQUIRE(pmap.size() == 3);
+        REQUIRE(pmap.interner().size() == 3);
+        auto [maxKey, maxVal] = pmap.top();
+        REQUIRE(maxKey == "https://a.example/x");
+        REQUIRE(maxVal == umap["https://a.example/x"]);
+        REQUIRE(pmap.get("https://b.example/y") == 2);
+    }
+
+    SECTION("Checking lookups never insert") {
+        pmap["seen"] = 4;
+        REQUIRE(pmap.contains("seen"));
+        REQUIRE(!pmap.contains("unseen"));
+        REQUIRE(!pmap.get("unseen"));
+        REQUIRE(pmap.count("unseen") == 0);
+        REQUIRE(pmap.interner().size() == 1);
+    }
+
+    SECTION("Checking erase() and pop() keep interned ids") {
+        ++pmap["a"];
+        ++pmap["b"];
+        ++pmap["b"];
+        REQUIRE(pmap.erase("a") == 1);
+        REQUIRE(pmap.erase("a") == 0);
+        REQUIRE(pmap.erase("never") == 0);
+        pmap.pop();
+        REQUIRE(pmap.empty());
+        --pmap["a"];
+        REQUIRE(pmap.interner().size() == 2);
+        REQUIRE(pmap.top().first == "a");
+        REQUIRE(pmap.top().second == -1);
+    }
+}
@@ -0,0 +1,107 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/algorithms/level_scheduler.hpp"
+#include "wilderfield/work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using wilderfield::algorithms::csr_graph;
+
+TEST_CASE("WorkStealingPool is tested", "[level_scheduler]") {
+
+    wilderfield::work_stealing_pool pool(4);
+
+    SECTION("Checking every task runs once") {
+        std::vector<std::atomic<int>> runs(1000);
+        for (auto& count : runs) {
+            count = 0;
+        }
+        for (size_t i = 0; i < runs.size(); i++) {
+            pool.submit([&runs, i] { runs[i]++; });
+        }
+        pool.wait();
+        REQUIRE(std::all_of(runs.begin(), runs.end(), [](const auto& count) { return count == 1; }));
+    }
+
+    SECTION("Checking tasks submitted by tasks are waited for") {
+        std::atomic<int> total(0);
+        for (int i = 0; i < 16; i++) {
+            pool.submit([&] {
+                for (int j = 0; j < 16; j++) {
+                    pool.submit([&] { total++; });
+                }
+            });
+        }
+        pool.wait();
+        REQUIRE(total == 256);
+    }
+
+    SECTION("Checking exceptions reach wait()") {
+        pool.submit([] { throw std::runtime_error("task failed"); });
+        pool.submit([] {});
+        REQUIRE_THROWS_AS(pool.wait(), std::runtime_error);
+        pool.submit([] {});
+        REQUIRE_NOTHROW(pool.wait());
+    }
+}
+
+TEST_CASE("LevelScheduler is tested", "[level_scheduler]") {
+
+    wilderfield::algorithms::level_scheduler scheduler(3);
+
+    SECTION("Checking tasks start after their predecessors finish") {
+        const csr_graph::node_type n = 3000;
+        std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>> edges;
+        unsigned seed = 11;
+        for (int i = 0; i < 15000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            auto a = (seed >> 8) % n;
+            seed = seed * 1103515245u + 12345u;
+            auto b = (seed >> 8) % n;
+            if (a != b) {
+                edges.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+        csr_graph graph(n, edges);
+
+        std::atomic<long> clock(0);
+        std::vector<long> started(n, -1);
+        std::vector<long> finished(n, -1);
+        auto result = scheduler.run(graph, [&](csr_graph::node_type u) {
+            started[u] = clock++;
+            finished[u] = clock++;
+        });
+
+        REQUIRE(result.acyclic);
+        REQUIRE(result.order.size() == n);
+        REQUIRE(std::all_of(started.begin(), started.end(), [](long t) { return t >= 0; }));
+        for (const auto& [u, v] : edges) {
+            REQUIRE(finished[u] < started[v]);
+        }
+        REQUIRE(result.level_offsets == wilderfield::algorithms::topological_sort(graph).level_offsets);
+    }
+
+    SECTION("Checking cycles stop the run") {
+        csr_graph graph(4, {{0, 1}, {1, 2}, {2, 1}, {0, 3}});
+        std::atomic<int> ran(0);
+        auto result = scheduler.run(graph, [&](csr_graph::node_type) { ran++; });
+        REQUIRE(!result.acyclic);
+        REQUIRE(ran == 2);
+    }
+
+    SECTION("Checking a failing task stops later levels") {
+        csr_graph graph(4, {{0, 2}, {1, 3}});
+        std::atomic<int> ran(0);
+        REQUIRE_THROWS_AS(scheduler.run(graph, [&](csr_graph::node_type u) {
+            ran++;
+            if (u == 0) {
+                throw std::runtime_error("task failed");
+            }
+        }), std::runtime_error);
+        REQUIRE(ran == 2);
+    }
+}
@@ -0,0 +1,77 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/algorithms/minimum_degree.hpp"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+using wilderfield::algorithms::csr_graph;
+
+TEST_CASE("MinimumDegreeOrdering is tested", "[minimum_degree]") {
+
+    SECTION("Checking trees are ordered without fill") {
+        // Star with a tail: 0 is the center, 5-6-7 hang off leaf 5
+        csr_graph graph(8, {{0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5}, {5, 6}, {6, 7}}, true);
+        auto result = wilderfield::algorithms::minimum_degree_ordering(graph);
+        REQUIRE(result.fill == 0);
+        auto sorted = result.order;
+        std::sort(sorted.begin(), sorted.end());
+        REQUIRE(sorted == std::vector<csr_graph::node_type>{0, 1, 2, 3, 4, 5, 6, 7});
+    }
+
+    SECTION("Checking a cycle fills one chord per elimination") {
+        csr_graph graph(6, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 5}, {5, 0}}, true);
+        auto result = wilderfield::algorithms::minimum_degree_ordering(graph);
+        REQUIRE(result.fill == 3);
+    }
+
+    SECTION("Checking every step against an explicit elimination") {
+        const csr_graph::node_type n = 300;
+        std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>> edges;
+        unsigned seed = 9;
+        auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for (int i = 0; i < 700; i++) {
+            edges.emplace_back(next() % n, next() % n); // Includes a few self loops and repeats
+        }
+        csr_graph graph(n, edges, true);
+        auto result = wilderfield::algorithms::minimum_degree_ordering(graph);
+        REQUIRE(result.order.size() == n);
+
+        std::vector<std::set<csr_graph::node_type>> adjacency(n);
+        for (const auto& [u, v] : edges) {
+            if (u != v) {
+                adjacency[u].insert(v);
+                adjacency[v].insert(u);
+            }
+        }
+        std::set<csr_graph::node_type> left;
+        for (csr_graph::node_type u = 0; u < n; u++) {
+            left.insert(u);
+        }
+
+        size_t fill = 0;
+        for (auto v : result.order) {
+            REQUIRE(left.count(v) == 1);
+            size_t smallest = n;
+            for (auto u : left) {
+                smallest = std::min(smallest, adjacency[u].size());
+            }
+            REQUIRE(adjacency[v].size() == smallest);
+
+            for (auto a : adjacency[v]) {
+                adjacency[a].erase(v);
+                for (auto b : adjacency[v]) {
+                    if (a < b && adjacency[a].insert(b).second) {
+                        adjacency[b].insert(a);
+                        fill++;
+                    }
+                }
+            }
+            adjacency[v].clear();
+            left.erase(v);
+        }
+        REQUIRE(result.fill == fill);
+    }
+}
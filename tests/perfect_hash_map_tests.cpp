@@ -0,0 +1,163 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/minimal_perfect_hash.hpp"
+#include "wilderfield/perfect_hash_map.hpp"
+#include "wilderfield/priority_map.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Sends keys a multiple of 1000 apart to the same value
+struct mod_1000_hash {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key % 1000); }
+};
+
+} // namespace
+
+TEST_CASE("PerfectHashMap operations are tested", "[perfect_hash_map]") {
+
+    std::vector<int> keys;
+    for (int i = 0; i < 5000; i++) {
+        keys.push_back(i * 7919);
+    }
+    keys.push_back(0); // Duplicates are ignored
+
+    wilderfield::perfect_hash_map<int, int> phm(keys.begin(), keys.end());
+
+    SECTION("Checking static keys") {
+        REQUIRE(phm.static_size() == 5000);
+        REQUIRE(phm.empty());
+        for (int i = 0; i < 5000; i++) {
+            REQUIRE(phm.find(i * 7919) == phm.end());
+            phm[i * 7919] = i;
+        }
+        REQUIRE(phm.size() == 5000);
+        REQUIRE(phm.fallback_size() == 0);
+        for (int i = 0; i < 5000; i++) {
+            REQUIRE(phm.at(i * 7919) == i);
+        }
+        REQUIRE(phm.erase(7919) == 1);
+        REQUIRE(phm.erase(7919) == 0);
+        REQUIRE(phm.count(7919) == 0);
+        REQUIRE(phm.size() == 4999);
+    }
+
+    SECTION("Checking unknown keys use the fallback") {
+        phm[1] = 5;
+        phm[0] = 6;
+        REQUIRE(phm.fallback_size() == 1);
+        REQUIRE(phm.size() == 2);
+        REQUIRE(phm.find(1)->second == 5);
+        REQUIRE(phm.erase(1) == 1);
+        REQUIRE(phm.count(1) == 0);
+        REQUIRE_THROWS_AS(phm.at(1), std::out_of_range);
+
+        auto [fallbackEntry, fallbackNew] = phm.try_emplace(2);
+        REQUIRE(fallbackNew);
+        REQUIRE(fallbackEntry == phm.find(2));
+        auto [staticEntry, staticNew] = phm.try_emplace(0);
+        REQUIRE(!staticNew);
+        REQUIRE(staticEntry->second == 6);
+    }
+
+    SECTION("Checking an empty key set") {
+        wilderfield::perfect_hash_map<std::string, int> empty;
+        REQUIRE(empty.count("a") == 0);
+        empty["a"] = 1;
+        REQUIRE(empty.at("a") == 1);
+    }
+}
+
+TEST_CASE("PriorityMap with a perfect hash key index", "[perfect_hash_map]") {
+
+    using pmap_type = wilderfield::priority_map<int, int, std::less<int>, std::hash<int>, wilderfield::perfect_hash_map>;
+
+    // Test graph
+    std::vector<std::vector<int>> graph(6);
+    graph[0] = {1, 3};
+    graph[2] = {0, 4};
+    graph[3] = {1};
+    graph[4] = {3, 5};
+    graph[5] = {1};
+
+    std::vector<int> nodes = {0, 1, 2, 3, 4, 5};
+    pmap_type pmap(pmap_type::key_index_type(nodes.begin(), nodes.end()));
+
+    for (int u = 0; u < 6; u++) {
+        pmap[u] = 0;
+    }
+    for (int u = 0; u < 6; u++) {
+        for (auto v : graph[u]) {
+            ++pmap[v];
+        }
+    }
+
+    std::vector<int> topological;
+    while (!pmap.empty()) {
+        auto [u, minVal] = pmap.top(); pmap.pop();
+        REQUIRE(minVal == 0);
+        topological.push_back(u);
+        for (auto v : graph[u]) {
+            --pmap[v];
+        }
+    }
+    REQUIRE(topological.size() == 6);
+    REQUIRE(topological.front() == 2);
+    REQUIRE(topological.back() == 1);
+
+    // Keys outside the static set still work
+    --pmap[42];
+    REQUIRE(pmap.top().first == 42);
+    REQUIRE(pmap.size() == 1);
+}
+
+TEST_CASE("MinimalPerfectHash maps keys to distinct indices", "[perfect_hash_map]") {
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 3000; i++) {
+        keys.push_back("key" + std::to_string(i * 31));
+    }
+    wilderfield::minimal_perfect_hash<std::string> mph(keys.begin(), keys.end());
+    REQUIRE(mph.size() == keys.size());
+
+    std::vector<bool> seen(keys.size(), false);
+    for (const auto& key : keys) {
+        const size_t index = mph(key);
+        REQUIRE(index < keys.size());
+        REQUIRE(!seen[index]);
+        seen[index] = true;
+    }
+    REQUIRE(mph(std::string("absent")) < keys.size());
+    REQUIRE(mph.memory_bytes() < keys.size() * sizeof(std::uint32_t));
+
+    keys.push_back("key31");
+    using mph_type = wilderfield::minimal_perfect_hash<std::string>;
+    REQUIRE_THROWS_AS(mph_type(keys.begin(), keys.end()), std::invalid_argument);
+}
+
+TEST_CASE("Perfect hashing with colliding Hash values", "[perfect_hash_map]") {
+
+    std::vector<int> keys = {1, 1001, 5};
+
+    using mph_type = wilderfield::minimal_perfect_hash<int, mod_1000_hash>;
+    REQUIRE_THROWS_AS(mph_type(keys.begin(), keys.end()), std::invalid_argument);
+
+    // The map gives the later colliding key no slot, so it lives in the fallback
+    wilderfield::perfect_hash_map<int, int, mod_1000_hash> phm(keys.begin(), keys.end());
+    REQUIRE(phm.static_size() == 2);
+    phm[1] = 10;
+    phm[1001] = 20;
+    phm[5] = 30;
+    REQUIRE(phm.size() == 3);
+    REQUIRE(phm.fallback_size() == 1);
+    REQUIRE(phm.at(1) == 10);
+    REQUIRE(phm.at(1001) == 20);
+    REQUIRE(phm.at(5) == 30);
+    REQUIRE(phm.erase(1001) == 1);
+    REQUIRE(phm.count(1001) == 0);
+    REQUIRE(phm.at(1) == 10);
+}
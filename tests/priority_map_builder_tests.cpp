@@ -0,0 +1,54 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/priority_map_builder.hpp"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+TEST_CASE("PriorityMapBuilder operations are tested", "[priority_map_builder]") {
+
+    wilderfield::priority_map_builder<char, int> builder;
+
+    SECTION("Checking finalize() orders the counted values") {
+        std::unordered_map<char, int> umap;
+        std::string s = "supercalifragilisticexpialidocious";
+        for (auto c : s) {
+            ++builder[c];
+            ++umap[c];
+        }
+        builder.add('z', 3);
+        umap['z'] += 3;
+        REQUIRE(builder.size() == umap.size());
+
+        auto pmap = builder.finalize();
+        REQUIRE(builder.empty());
+        REQUIRE(pmap.size() == umap.size());
+        for (auto& [key, val] : umap) {
+            REQUIRE(pmap.at(key) == val);
+        }
+        REQUIRE(pmap.top() == std::make_pair('i', 7));
+
+        // The built map keeps ordering on later updates
+        pmap['z'] = 8;
+        REQUIRE(pmap.top() == std::make_pair('z', 8));
+    }
+
+    SECTION("Checking finalize() of an empty builder") {
+        auto pmap = builder.finalize();
+        REQUIRE(pmap.empty());
+    }
+}
+
+TEST_CASE("PriorityMapBuilder for a min heap", "[priority_map_builder]") {
+
+    wilderfield::priority_map_builder<int, long, std::less<long>> builder;
+    builder.reserve(1000);
+    for (int i = 0; i < 100000; i++) {
+        builder.add(i % 1000, i % 1000 == 17 ? -1 : 1);
+    }
+    auto pmap = builder.finalize(4);
+    REQUIRE(pmap.size() == 1000);
+    REQUIRE(pmap.top() == std::make_pair(17, -100L));
+    pmap.pop();
+    REQUIRE(pmap.top().second == 100);
+}
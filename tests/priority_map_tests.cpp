@@ -2,12 +2,16 @@
 #include "catch2/catch.hpp"
 #include "wilderfield/priority_map.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
 
 #include <cstdlib> // For std::rand and std::srand
 #include <ctime>   // For std::time
+#include <cstdint>
 
 TEST_CASE("PriorityMap operations are tested", "[priority_map]") {
 
@@ -71,6 +75,17 @@ TEST_CASE("PriorityMap operations are tested", "[priority_map]") {
         }
     }
 
+    SECTION("Check compound assignment") {
+        pmap[7] += 3;
+        pmap[8] += 5;
+        pmap[8] -= 4;
+        REQUIRE(pmap[7] == 3);
+        REQUIRE(pmap[8] == 1);
+        REQUIRE(pmap.top() == std::make_pair(7, 3));
+        pmap[7] -= 3;
+        REQUIRE(pmap.top() == std::make_pair(8, 1));
+    }
+
     SECTION("Checking top()") {
         ++pmap[7];
         ++pmap[7];
@@ -112,6 +127,115 @@ TEST_CASE("PriorityMap operations are tested", "[priority_map]") {
         REQUIRE(pmap.empty());
     }
 
+    SECTION("Checking try_top() and try_pop()") {
+        REQUIRE(noexcept(pmap.try_top()));
+        REQUIRE(noexcept(pmap.try_pop()));
+        REQUIRE(!pmap.try_top());
+        REQUIRE(!pmap.try_pop());
+        ++pmap[7];
+        ++pmap[7];
+        ++pmap[11];
+        {
+            auto top = pmap.try_top();
+            REQUIRE(top);
+            REQUIRE(top->first == 7);
+            REQUIRE(top->second == 2);
+        }
+        REQUIRE(pmap.try_pop());
+        REQUIRE(pmap.try_top()->first == 11);
+        REQUIRE(pmap.try_pop());
+        REQUIRE(!pmap.try_pop());
+        REQUIRE(pmap.empty());
+    }
+
+    SECTION("Checking non-inserting lookups") {
+        REQUIRE(noexcept(pmap.find(7)));
+        REQUIRE(noexcept(pmap.value_or(7, 0)));
+        pmap[7] = 3;
+        const auto& cpmap = pmap;
+        REQUIRE(cpmap.find(7) != nullptr);
+        REQUIRE(*cpmap.find(7) == 3);
+        REQUIRE(cpmap.find(8) == nullptr);
+        REQUIRE(cpmap.value_or(7, -1) == 3);
+        REQUIRE(cpmap.value_or(8, -1) == -1);
+        REQUIRE(cpmap.at(7) == 3);
+        REQUIRE_THROWS_AS(cpmap.at(8), std::out_of_range);
+        REQUIRE(pmap.size() == 1);
+        REQUIRE(pmap.count(8) == 0);
+    }
+
+    SECTION("Checking get() and contains()") {
+        REQUIRE(noexcept(pmap.get(7)));
+        REQUIRE(noexcept(pmap.contains(7)));
+        --pmap[7];
+        const auto& cpmap = pmap;
+        REQUIRE(cpmap.contains(7));
+        REQUIRE(!cpmap.contains(8));
+        REQUIRE(cpmap.get(7) == -1);
+        REQUIRE(!cpmap.get(8));
+        REQUIRE(pmap.size() == 1);
+    }
+
+    SECTION("Checking top_k()") {
+        REQUIRE(pmap.top_k(3).empty());
+        pmap[1] = 5;
+        pmap[2] = 9;
+        pmap[3] = 5;
+        pmap[4] = 1;
+        auto top = pmap.top_k(3);
+        REQUIRE(top.size() == 3);
+        REQUIRE(top[0] == std::make_pair(2, 9));
+        REQUIRE(top[1].second == 5);
+        REQUIRE(top[2].second == 5);
+        REQUIRE(top[1].first + top[2].first == 4);
+        REQUIRE(pmap.top_k(10).size() == 4);
+        REQUIRE(pmap.top_k(0).empty());
+    }
+
+    SECTION("Checking pop_top_bucket()") {
+        std::vector<int> popped;
+        pmap.pop_top_bucket(std::back_inserter(popped));
+        REQUIRE(popped.empty());
+        pmap[1] = 4;
+        pmap[2] = 4;
+        pmap[3] = 2;
+        pmap.pop_top_bucket(std::back_inserter(popped));
+        std::sort(popped.begin(), popped.end());
+        REQUIRE(popped == std::vector<int>{1, 2});
+        REQUIRE(pmap.size() == 1);
+        REQUIRE(!pmap.contains(1));
+        REQUIRE(pmap.top() == std::make_pair(3, 2));
+        pmap[1] = 7;
+        REQUIRE(pmap.top() == std::make_pair(1, 7));
+    }
+
+    SECTION("Checking batch increments") {
+        std::vector<int> keys = {7, 8, 7, 9, 7, 8};
+        pmap.increment_many(keys.begin(), keys.end());
+        pmap.increment_many(keys.begin(), keys.begin() + 1, -5);
+        REQUIRE(pmap.at(7) == -2);
+        REQUIRE(pmap.at(8) == 2);
+        REQUIRE(pmap.top() == std::make_pair(8, 2));
+
+        REQUIRE(pmap.at(9) == 1);
+        REQUIRE(pmap.size() == 3);
+    }
+
+    SECTION("Checking batch increments match single increments") {
+        wilderfield::priority_map<int, int> single;
+        std::vector<int> keys;
+        for (int i = 0; i < 5000; i++) {
+            keys.push_back((i * i) % 613);
+            ++single[keys.back()];
+        }
+        pmap.increment_many(keys.begin(), keys.end());
+        REQUIRE(pmap.size() == single.size());
+        for (int key : keys) {
+            REQUIRE(pmap.at(key) == single.at(key));
+        }
+        REQUIRE(pmap.top().second == single.top().second);
+    }
+
     SECTION("Checking frequency map") {
 
         wilderfield::priority_map<char, int> pmap;
@@ -309,6 +433,139 @@ TEST_CASE("PriorityMap operations are tested", "[priority_map]") {
         REQUIRE(currentMinKeys.count(minKey) >= 1);
     }
 
+    SECTION("Checking far assignments mixed with steps and pops") {
+        wilderfield::priority_map<int, long, std::less<long>> pmap;
+        std::unordered_map<int, long> reference;
+        unsigned seed = 7;
+        auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+
+        for (int i = 0; i < 20000; ++i) {
+            const int key = static_cast<int>(next() % 500);
+            // The second quarter only steps, long enough for the map to drop its value index
+            switch (i / 5000 == 1 ? 2 + next() % 2 : next() % 5) {
+            case 0:
+            case 1:
+                // Mostly unique values far from the key's current one
+                pmap[key] = reference[key] = static_cast<long>(next() % 100000);
+                break;
+            case 2:
+                ++pmap[key];
+                ++reference[key];
+                break;
+            case 3:
+                --pmap[key];
+                --reference[key];
+                break;
+            default:
+                if (!pmap.empty()) {
+                    REQUIRE(reference.at(pmap.top().first) == pmap.top().second);
+                    reference.erase(pmap.top().first);
+                    pmap.pop();
+                }
+            }
+
+            if (i % 1000 == 0) {
+                auto all = pmap.top_k(pmap.size());
+                REQUIRE(all.size() == reference.size());
+                for (size_t j = 0; j < all.size(); ++j) {
+                    REQUIRE(reference.at(all[j].first) == all[j].second);
+                    REQUIRE((j == 0 || all[j - 1].second <= all[j].second));
+                }
+            }
+        }
+    }
+
+    SECTION("Checking copies are deep and keep bucket order") {
+        for (int i = 0; i < 50; i++) {
+            pmap[i] = i % 7;
+        }
+        auto copy = pmap;
+        REQUIRE(copy.top_k(50) == pmap.top_k(50));
+
+        // Changing one leaves the other untouched
+        ++copy[3];
+        copy.erase(6);
+        copy.pop();
+        REQUIRE(pmap.size() == 50);
+        REQUIRE(pmap.at(3) == 3);
+        REQUIRE(pmap.at(6) == 6);
+        REQUIRE(copy.size() == 48);
+        REQUIRE(copy.at(3) == 4);
+
+        pmap = copy;
+        REQUIRE(pmap.top_k(48) == copy.top_k(48));
+        std::vector<int> popped;
+        pmap.pop_top_bucket(std::back_inserter(popped));
+        REQUIRE(copy.size() == 48);
+        REQUIRE(copy.size() - pmap.size() == popped.size());
+    }
 
 }
 
+TEST_CASE("PriorityMap bulk load is tested", "[priority_map]") {
+
+    std::vector<std::pair<int, int>> items;
+    for (int i = 0; i < 100000; i++) {
+        items.emplace_back(i, (i * 7919) % 1000 - 500);
+    }
+
+    SECTION("Checking bulk load matches incremental inserts") {
+        for (size_t threads : {1, 3, 8}) {
+            wilderfield::priority_map<int, int> pmap(items.begin(), items.end(), threads);
+            REQUIRE(pmap.size() == items.size());
+            for (int i = 0; i < 100000; i += 997) {
+                REQUIRE(pmap.at(i) == (i * 7919) % 1000 - 500);
+            }
+            int last = 1000;
+            while (!pmap.empty()) {
+                auto [key, val] = pmap.top();
+                REQUIRE(val <= last);
+                REQUIRE(val == (key * 7919) % 1000 - 500);
+                last = val;
+                pmap.pop();
+            }
+        }
+    }
+
+    SECTION("Checking bulk load of a min heap keeps updating") {
+        wilderfield::priority_map<int, int, std::less<int>> pmap(items.begin(), items.end(), 4);
+        REQUIRE(pmap.top().second == -500);
+        pmap[5] = -1000;
+        REQUIRE(pmap.top() == std::make_pair(5, -1000));
+        ++pmap[5];
+        REQUIRE(pmap.top().second == -999);
+    }
+
+    SECTION("Checking radix grouping over the full value range") {
+        std::vector<std::pair<int, long long>> wide = {{1, 0}, {2, -1}, {3, INT64_MIN}, {4, INT64_MAX}, {5, 1LL << 40}, {6, -(1LL << 40)}};
+        wilderfield::priority_map<int, long long, std::less<long long>> minMap(wide.begin(), wide.end());
+        std::vector<int> order;
+        while (!minMap.empty()) {
+            order.push_back(minMap.top().first);
+            minMap.pop();
+        }
+        REQUIRE(order == std::vector<int>{3, 6, 2, 1, 5, 4});
+
+        std::vector<std::pair<int, unsigned char>> small = {{1, 200}, {2, 7}, {3, 255}, {4, 7}};
+        wilderfield::priority_map<int, unsigned char> maxMap(small.begin(), small.end());
+        REQUIRE(maxMap.top() == std::make_pair(3, static_cast<unsigned char>(255)));
+        REQUIRE(maxMap.top_k(4)[3].second == 7);
+    }
+
+    SECTION("Checking bulk load of floating point values") {
+        std::vector<std::pair<int, double>> reals;
+        for (int i = 0; i < 50000; i++) {
+            reals.emplace_back(i, (i % 977) * 0.5);
+        }
+        wilderfield::priority_map<int, double> pmap(reals.begin(), reals.end(), 2);
+        REQUIRE(pmap.size() == reals.size());
+        REQUIRE(pmap.top().second == 488.0);
+        REQUIRE(pmap.at(976) == 488.0);
+    }
+
+    SECTION("Checking duplicate keys are rejected") {
+        items.emplace_back(42, 7);
+        using pmap_type = wilderfield::priority_map<int, int>;
+        REQUIRE_THROWS_AS(pmap_type(items.begin(), items.end(), 4), std::invalid_argument);
+    }
+}
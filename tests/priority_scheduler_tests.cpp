@@ -0,0 +1,132 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/priority_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// A task id whose std::hash fails for one id, so queueing that task throws
+struct flaky_task {
+    int id;
+    bool operator==(const flaky_task& other) const { return id == other.id; }
+};
+
+std::atomic<int> failingId(-1);
+
+struct flaky_task_home {
+    std::size_t operator()(const flaky_task& task) const { return std::hash<int>()(task.id); }
+};
+
+} // namespace
+
+namespace std {
+template<>
+struct hash<flaky_task> {
+    size_t operator()(const flaky_task& task) const {
+        if (task.id == failingId) {
+            throw runtime_error("hash failed");
+        }
+        return hash<int>()(task.id);
+    }
+};
+} // namespace std
+
+TEST_CASE("PriorityScheduler is tested", "[priority_scheduler]") {
+
+    SECTION("Checking every task runs once") {
+        std::vector<std::atomic<int>> runs(2000);
+        for (auto& count : runs) {
+            count = 0;
+        }
+        wilderfield::priority_scheduler<int> scheduler(4, [&](const int& task) { runs[task]++; });
+        for (int i = 0; i < 2000; i++) {
+            scheduler.submit(i, i % 7);
+        }
+        scheduler.wait();
+        REQUIRE(std::all_of(runs.begin(), runs.end(), [](const auto& count) { return count == 1; }));
+    }
+
+    SECTION("Checking a single worker runs in priority order") {
+        std::mutex gate;
+        std::vector<int> order;
+        wilderfield::priority_scheduler<int> scheduler(1, [&](const int& task) {
+            std::lock_guard<std::mutex> lock(gate);
+            order.push_back(task);
+        });
+
+        // Hold the worker in the first task while the rest are queued and adjusted
+        gate.lock();
+        scheduler.submit(0, 100);
+        while (scheduler.priority(0)) {
+        }
+        scheduler.submit(1, 1);
+        scheduler.submit(2, 2);
+        scheduler.submit(3, 3);
+        REQUIRE(scheduler.increase(1));
+        REQUIRE(scheduler.increase(1));
+        REQUIRE(scheduler.increase(1));
+        REQUIRE(scheduler.decrease(3));
+        REQUIRE(scheduler.reprioritize(2, -5));
+        REQUIRE(scheduler.priority(1) == 4);
+        REQUIRE(!scheduler.increase(0));
+        REQUIRE(!scheduler.priority(7));
+        REQUIRE_THROWS_AS(scheduler.submit(3, 9), std::invalid_argument);
+        gate.unlock();
+
+        scheduler.wait();
+        REQUIRE(order == std::vector<int>{0, 1, 3, 2});
+    }
+
+    SECTION("Checking tasks can submit and adjust other tasks") {
+        std::atomic<int> total(0);
+        wilderfield::priority_scheduler<int> scheduler(3, [&](const int& task) {
+            total++;
+            if (task < 100) {
+                scheduler.submit(task + 100, 0);
+                scheduler.increase(task + 100);
+            }
+        });
+        for (int i = 0; i < 100; i++) {
+            scheduler.submit(i, 1);
+        }
+        scheduler.wait();
+        REQUIRE(total == 200);
+    }
+
+    SECTION("Checking exceptions reach wait()") {
+        wilderfield::priority_scheduler<int> scheduler(2, [](const int& task) {
+            if (task == 3) {
+                throw std::runtime_error("task failed");
+            }
+        });
+        for (int i = 0; i < 10; i++) {
+            scheduler.submit(i, i);
+        }
+        REQUIRE_THROWS_AS(scheduler.wait(), std::runtime_error);
+        scheduler.submit(3, 0);
+        REQUIRE_THROWS_AS(scheduler.wait(), std::runtime_error);
+        scheduler.submit(4, 0);
+        REQUIRE_NOTHROW(scheduler.wait());
+    }
+
+    SECTION("Checking a failed submit leaves wait() free to return") {
+        std::atomic<int> runs(0);
+        wilderfield::priority_scheduler<flaky_task, int, flaky_task_home> scheduler(2, [&](const flaky_task&) { runs++; });
+
+        failingId = 1;
+        REQUIRE_THROWS_AS(scheduler.submit(flaky_task{1}, 0), std::runtime_error);
+        failingId = -1;
+        scheduler.wait();
+        REQUIRE(runs == 0);
+
+        scheduler.submit(flaky_task{1}, 0);
+        scheduler.wait();
+        REQUIRE(runs == 1);
+    }
+}
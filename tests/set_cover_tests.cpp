@@ -0,0 +1,82 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/set_cover.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("GreedySetCover is tested", "[set_cover]") {
+
+    // Greedy picks the big set first, then needs both halves' leftovers
+    std::vector<std::vector<std::uint32_t>> sets = {
+        {0, 1, 2, 3},
+        {0, 1, 2, 3, 4, 5},
+        {4, 5, 6},
+        {6, 7, 7},
+        {8},
+    };
+
+    SECTION("Checking a small cover") {
+        auto result = wilderfield::algorithms::greedy_set_cover(sets, 10);
+        REQUIRE(result.chosen == std::vector<std::uint32_t>{1, 3, 4});
+        REQUIRE(result.gains == std::vector<std::size_t>{6, 2, 1});
+        REQUIRE(result.covered == 9); // Element 9 is in no set
+    }
+
+    SECTION("Checking a budget gives maximum coverage") {
+        auto result = wilderfield::algorithms::greedy_set_cover(sets, 10, 2);
+        REQUIRE(result.chosen.size() == 2);
+        REQUIRE(result.covered == 8);
+    }
+
+    SECTION("Checking gains against recounting on a random instance") {
+        const std::uint32_t elements = 5000;
+        std::vector<std::vector<std::uint32_t>> randomSets(800);
+        unsigned seed = 21;
+        auto next = [&seed] { seed = seed * 1103515245u + 12345u; return seed >> 8; };
+        for (auto& set : randomSets) {
+            const unsigned size = 1 + next() % 40;
+            for (unsigned i = 0; i < size; i++) {
+                set.push_back(next() % elements);
+            }
+        }
+        auto result = wilderfield::algorithms::greedy_set_cover(randomSets, elements);
+
+        // Every pick must have the largest gain left at the time
+        std::vector<bool> covered(elements, false);
+        std::vector<bool> chosen(randomSets.size(), false);
+        auto gainOf = [&](const std::vector<std::uint32_t>& set) {
+            std::vector<std::uint32_t> fresh;
+            for (auto e : set) {
+                if (!covered[e]) {
+                    fresh.push_back(e);
+                }
+            }
+            std::sort(fresh.begin(), fresh.end());
+            return static_cast<std::size_t>(std::unique(fresh.begin(), fresh.end()) - fresh.begin());
+        };
+        for (size_t i = 0; i < result.chosen.size(); i++) {
+            size_t best = 0;
+            for (size_t s = 0; s < randomSets.size(); s++) {
+                if (!chosen[s]) {
+                    best = std::max(best, gainOf(randomSets[s]));
+                }
+            }
+            REQUIRE(gainOf(randomSets[result.chosen[i]]) == best);
+            REQUIRE(result.gains[i] == best);
+            chosen[result.chosen[i]] = true;
+            for (auto e : randomSets[result.chosen[i]]) {
+                covered[e] = true;
+            }
+        }
+        for (size_t s = 0; s < randomSets.size(); s++) {
+            REQUIRE(gainOf(randomSets[s]) == 0);
+        }
+        REQUIRE(result.covered == static_cast<size_t>(std::count(covered.begin(), covered.end(), true)));
+    }
+
+    SECTION("Checking elements out of range are rejected") {
+        REQUIRE_THROWS_AS(wilderfield::algorithms::greedy_set_cover(sets, 8), std::invalid_argument);
+    }
+}
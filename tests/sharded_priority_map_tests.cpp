@@ -0,0 +1,65 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/sharded_priority_map.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("ShardedPriorityMap operations are tested", "[sharded_priority_map]") {
+
+    wilderfield::sharded_priority_map<int, int> pmap(4);
+
+    SECTION("Checking shard placement") {
+        REQUIRE(pmap.shard_count() == 4);
+        for (size_t i = 0; i < pmap.shard_count(); i++) {
+            REQUIRE(pmap.shard_node(i) == static_cast<int>(i % pmap.numa_nodes()));
+        }
+    }
+
+    SECTION("Checking updates are applied in order") {
+        pmap.add(1, 3);
+        pmap.assign(1, 10);
+        pmap.add(1, -4);
+        pmap.add(2, 7);
+        pmap.erase(2);
+        REQUIRE(pmap.get(1) == 6);
+        REQUIRE(!pmap.get(2));
+        REQUIRE(pmap.size() == 1);
+    }
+
+    SECTION("Checking top_k() against a single map") {
+        std::unordered_map<int, int> reference;
+        std::vector<std::thread> producers;
+        for (int t = 0; t < 4; t++) {
+            producers.emplace_back([&pmap, t] {
+                for (int i = 0; i < 5000; i++) {
+                    pmap.add((i * 7 + t) % 1000, 1 + i % 3);
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        for (int t = 0; t < 4; t++) {
+            for (int i = 0; i < 5000; i++) {
+                reference[(i * 7 + t) % 1000] += 1 + i % 3;
+            }
+        }
+
+        REQUIRE(pmap.size() == reference.size());
+        std::vector<int> vals;
+        for (auto& [key, val] : reference) {
+            vals.push_back(val);
+        }
+        std::sort(vals.begin(), vals.end(), std::greater<int>());
+
+        auto top = pmap.top_k(50);
+        REQUIRE(top.size() == 50);
+        for (size_t i = 0; i < top.size(); i++) {
+            REQUIRE(top[i].second == vals[i]);
+            REQUIRE(reference[top[i].first] == top[i].second);
+        }
+    }
+}
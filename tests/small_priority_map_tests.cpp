@@ -0,0 +1,167 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/small_priority_map.hpp"
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("SmallPriorityMap operations are tested", "[small_priority_map]") {
+
+    wilderfield::small_priority_map<int, int, 4> pmap;
+
+    SECTION("Checking footprint") {
+        REQUIRE(sizeof(wilderfield::small_priority_map<int, int>) < sizeof(wilderfield::priority_map<int, int>));
+    }
+
+    SECTION("Checking empty(), size(), count() and erase()") {
+        REQUIRE(pmap.empty());
+        ++pmap[7];
+        ++pmap[8];
+        REQUIRE(pmap.size() == 2);
+        REQUIRE(pmap.count(7) == 1);
+        REQUIRE(pmap.count(9) == 0);
+        REQUIRE(pmap.erase(7) == 1);
+        REQUIRE(pmap.erase(7) == 0);
+        REQUIRE(pmap.size() == 1);
+        REQUIRE(pmap[8] == 1);
+    }
+
+    SECTION("Checking top() and pop() inline") {
+        ++pmap[7];
+        ++pmap[7];
+        ++pmap[7];
+        ++pmap[11];
+        ++pmap[11];
+        --pmap[3];
+        REQUIRE(pmap.is_inline());
+        {
+            auto [maxKey, maxVal] = pmap.top();
+            REQUIRE(maxKey == 7);
+            REQUIRE(maxVal == 3);
+            pmap.pop();
+        }
+        {
+            auto [maxKey, maxVal] = pmap.top();
+            REQUIRE(maxKey == 11);
+            REQUIRE(maxVal == 2);
+            pmap.pop();
+        }
+        {
+            auto [maxKey, maxVal] = pmap.top();
+            REQUIRE(maxKey == 3);
+            REQUIRE(maxVal == -1);
+            pmap.pop();
+        }
+        REQUIRE(pmap.empty());
+        REQUIRE_THROWS_AS(pmap.top(), std::out_of_range);
+        REQUIRE_THROWS_AS(pmap.pop(), std::out_of_range);
+    }
+
+    SECTION("Checking promotion") {
+        for (int i = 0; i < 4; i++) {
+            pmap[i] = i;
+        }
+        REQUIRE(pmap.is_inline());
+        pmap[4] = 2;
+        REQUIRE(!pmap.is_inline());
+        REQUIRE(pmap.size() == 5);
+        REQUIRE(pmap[3] == 3);
+        REQUIRE(pmap[4] == 2);
+        ++pmap[4];
+        ++pmap[4];
+        {
+            auto [maxKey, maxVal] = pmap.top();
+            REQUIRE(maxKey == 4);
+            REQUIRE(maxVal == 4);
+        }
+        REQUIRE(pmap.erase(4) == 1);
+        REQUIRE(pmap.top().first == 3);
+    }
+
+    SECTION("Checking copies are deep, inline and promoted") {
+        pmap[1] = 5;
+        auto copy = pmap;
+        copy[1] = 9;
+        REQUIRE(pmap.top() == std::make_pair(1, 5));
+        REQUIRE(copy.top() == std::make_pair(1, 9));
+
+        for (int i = 2; i < 10; i++) {
+            pmap[i] = i;
+        }
+        REQUIRE(!pmap.is_inline());
+        copy = pmap;
+        REQUIRE(!copy.is_inline());
+        copy.pop();
+        REQUIRE(copy.size() == 8);
+        REQUIRE(pmap.size() == 9);
+        REQUIRE(pmap.top() == std::make_pair(9, 9));
+    }
+
+    SECTION("Checking vacated slots release their keys") {
+        wilderfield::small_priority_map<std::shared_ptr<int>, int, 4> owners;
+        std::vector<std::shared_ptr<int>> keys;
+        for (int i = 0; i < 4; i++) {
+            keys.push_back(std::make_shared<int>(i));
+            owners[keys.back()] = i;
+        }
+        REQUIRE(keys[3].use_count() == 2);
+        owners.pop();
+        REQUIRE(keys[3].use_count() == 1);
+        REQUIRE(owners.erase(keys[0]) == 1);
+        REQUIRE(keys[0].use_count() == 1);
+
+        // Promotion leaves only the priority_map holding the keys
+        for (int i = 4; i < 7; i++) {
+            keys.push_back(std::make_shared<int>(i));
+            owners[keys.back()] = i;
+        }
+        REQUIRE(!owners.is_inline());
+        REQUIRE(keys[1].use_count() == 2);
+        REQUIRE(keys[6].use_count() == 2);
+    }
+
+    SECTION("Checking frequency map with string keys") {
+
+        wilderfield::small_priority_map<std::string, int, 16> smap;
+        std::unordered_map<std::string, int> umap;
+
+        for (auto word : {"a", "b", "a", "c", "a", "b", "d"}) {
+            ++smap[word];
+            ++umap[word];
+        }
+        REQUIRE(smap.is_inline());
+        auto [maxKey, maxVal] = smap.top();
+        REQUIRE(maxKey == "a");
+        REQUIRE(maxVal == umap["a"]);
+    }
+
+    SECTION("Stress against priority_map MinHeap") {
+        wilderfield::small_priority_map<int, int, 8, std::less<int>> smap;
+        wilderfield::priority_map<int, int, std::less<int>> reference;
+
+        unsigned seed = 12345;
+        for (int i = 0; i < 2000; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            int key = (seed >> 16) % 12;
+            if ((seed >> 8) % 3 == 0) {
+                smap.erase(key);
+                reference.erase(key);
+            }
+            else if ((seed >> 8) % 3 == 1) {
+                --smap[key];
+                --reference[key];
+            }
+            else {
+                ++smap[key];
+                ++reference[key];
+            }
+            REQUIRE(smap.size() == reference.size());
+            if (!reference.empty()) {
+                REQUIRE(smap.top().second == reference.top().second);
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include "catch2/catch.hpp"
+#include "wilderfield/algorithms/csr_graph.hpp"
+#include "wilderfield/algorithms/topological_sort.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using wilderfield::algorithms::csr_graph;
+
+TEST_CASE("TopologicalSort is tested", "[topological_sort]") {
+
+    SECTION("Checking levels of a small DAG") {
+        // Same graph as the Kahn's algorithm test of priority_map
+        csr_graph graph(6, {{0, 1}, {0, 3}, {2, 0}, {2, 4}, {3, 1}, {4, 3}, {4, 5}, {5, 1}});
+        auto result = wilderfield::algorithms::topological_sort(graph);
+        REQUIRE(result.acyclic);
+        REQUIRE(result.level_count() == 4);
+        REQUIRE(result.level_offsets == std::vector<std::size_t>{0, 1, 3, 5, 6});
+        REQUIRE(result.order[0] == 2);
+        std::vector<csr_graph::node_type> level1(result.order.begin() + 1, result.order.begin() + 3);
+        std::sort(level1.begin(), level1.end());
+        REQUIRE(level1 == std::vector<csr_graph::node_type>{0, 4});
+        REQUIRE(result.order.back() == 1);
+    }
+
+    SECTION("Checking every edge points forward in a random DAG") {
+        const csr_graph::node_type n = 2000;
+        std::vector<std::pair<csr_graph::node_type, csr_graph::node_type>> edges;
+        unsigned seed = 3;
+        for (int i = 0; i < 10000; i++) {
+            seed = seed * 1103515245u + 12345u;
+            auto a = (seed >> 8) % n;
+            seed = seed * 1103515245u + 12345u;
+            auto b = (seed >> 8) % n;
+            if (a != b) {
+                edges.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+        csr_graph graph(n, edges);
+        auto result = wilderfield::algorithms::topological_sort(graph);
+        REQUIRE(result.acyclic);
+        REQUIRE(result.order.size() == n);
+
+        std::vector<std::size_t> level(n);
+        for (std::size_t l = 0; l < result.level_count(); l++) {
+            for (auto i = result.level_offsets[l]; i < result.level_offsets[l + 1]; i++) {
+                level[result.order[i]] = l;
+            }
+        }
+        for (const auto& [u, v] : edges) {
+            REQUIRE(level[u] < level[v]);
+        }
+    }
+
+    SECTION("Checking cycles are reported") {
+        csr_graph graph(5, {{0, 1}, {1, 2}, {2, 3}, {3, 1}, {0, 4}});
+        auto result = wilderfield::algorithms::topological_sort(graph);
+        REQUIRE(!result.acyclic);
+        std::sort(result.order.begin(), result.order.end());
+        REQUIRE(result.order == std::vector<csr_graph::node_type>{0, 4});
+    }
+
+    SECTION("Checking an empty graph") {
+        auto result = wilderfield::algorithms::topological_sort(csr_graph());
+        REQUIRE(result.acyclic);
+        REQUIRE(result.order.empty());
+        REQUIRE(result.level_count() == 0);
+    }
+}
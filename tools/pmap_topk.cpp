@@ -0,0 +1,295 @@
+/**
+ * @file pmap_topk.cpp
+ * @brief pmap-topk Command-Line Tool
+ *
+ * Prints the k most frequent values of a field across the nonblank lines of
+ * one or more files, e.g. the top client addresses of an access log:
+ *
+ *     pmap-topk -k 20 -f 1 -d ' ' access.log
+ *
+ * Files are memory mapped and cut into chunks on line boundaries. Worker
+ * threads claim chunks one at a time and tally the field of each line in a
+ * hash table keyed by views into the mapping, so no token is copied. Each
+ * worker then bulk loads its tallies into a priority_map of its own, rather
+ * than moving a key between buckets on every occurrence. The per-thread maps
+ * are folded into the first one and its top k is printed, one
+ * "count<TAB>value" line each, most frequent first.
+ */
+
+#include "wilderfield/priority_map.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using count_map = wilderfield::priority_map<std::string_view, std::size_t>;
+using tally_map = std::unordered_map<std::string_view, std::size_t>;
+
+constexpr std::size_t chunkBytes = std::size_t(32) << 20; // Large enough to amortize claiming, small enough to balance
+
+struct options {
+    std::size_t k = 10;
+    std::size_t field = 0; // 1-based, 0 for the whole line
+    char delimiter = ' ';
+    std::size_t threads = 0;
+    std::vector<std::string> files;
+};
+
+// A read-only mapping of a whole file, unmapped on destruction
+class mapped_file {
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    explicit mapped_file(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error(path + ": " + std::strerror(errno));
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::runtime_error(path + ": " + std::strerror(error));
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        if (size_ > 0) {
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                throw std::runtime_error(path + ": " + std::strerror(error));
+            }
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(data);
+        }
+        ::close(fd);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    std::string_view view() const { return {data_, size_}; }
+};
+
+[[noreturn]] void usage(const char* message = nullptr) {
+    if (message != nullptr) {
+        std::fprintf(stderr, "pmap-topk: %s\n", message);
+    }
+    std::fprintf(stderr,
+                 "usage: pmap-topk [-k count] [-f field] [-d delimiter] [-t threads] file...\n"
+                 "  -k count      values to print (default 10)\n"
+                 "  -f field      1-based field to count, 0 for the whole line (default 0)\n"
+                 "  -d delimiter  single field delimiter, or \"tab\" (default space)\n"
+                 "  -t threads    worker threads, 0 for all hardware threads (default 0)\n");
+    std::exit(2);
+}
+
+std::size_t parseCount(const char* text, const char* option) {
+
+    // strtoull skips leading spaces and negates a minus sign, so reject " -1" by hand
+    const char* digits = text;
+    while (std::isspace(static_cast<unsigned char>(*digits))) {
+        digits++;
+    }
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long value = std::strtoull(text, &end, 10);
+    if (errno != 0 || end == text || *end != '\0' || *digits == '-') {
+        usage((std::string("invalid value for ") + option + ": " + text).c_str());
+    }
+    return static_cast<std::size_t>(value);
+}
+
+options parseOptions(int argc, char** argv) {
+    options opts;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            usage();
+        }
+        if (arg == "-k" || arg == "-f" || arg == "-d" || arg == "-t") {
+            if (i + 1 == argc) {
+                usage((arg + " needs a value").c_str());
+            }
+            const char* value = argv[++i];
+            if (arg == "-k") {
+                opts.k = parseCount(value, "-k");
+            }
+            else if (arg == "-f") {
+                opts.field = parseCount(value, "-f");
+            }
+            else if (arg == "-t") {
+                opts.threads = parseCount(value, "-t");
+            }
+            else if (std::string(value) == "tab") {
+                opts.delimiter = '\t';
+            }
+            else if (std::strlen(value) == 1) {
+                opts.delimiter = value[0];
+            }
+            else {
+                usage("the delimiter must be a single character");
+            }
+        }
+        else if (arg.size() > 1 && arg[0] == '-') {
+            usage(("unknown option " + arg).c_str());
+        }
+        else {
+            opts.files.push_back(arg);
+        }
+    }
+    if (opts.files.empty()) {
+        usage("no input files");
+    }
+    return opts;
+}
+
+// Splits text into pieces of about chunkBytes, each ending just after a newline or at the end
+void splitLines(std::string_view text, std::vector<std::string_view>& chunks) {
+    std::size_t begin = 0;
+    while (begin < text.size()) {
+        std::size_t end = std::min(begin + chunkBytes, text.size());
+        if (end < text.size()) {
+            const std::size_t newline = text.find('\n', end - 1);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+}
+
+// Returns the selected field of line, or an empty view with a null data pointer if the line has too few fields
+std::string_view selectField(std::string_view line, std::size_t field, char delimiter) {
+    if (field == 0) {
+        return line;
+    }
+    const char* begin = line.data();
+    const char* const end = line.data() + line.size();
+    for (std::size_t f = 1; f < field; f++) {
+        const void* next = std::memchr(begin, delimiter, static_cast<std::size_t>(end - begin));
+        if (next == nullptr) {
+            return {};
+        }
+        begin = static_cast<const char*>(next) + 1;
+    }
+    const void* stop = std::memchr(begin, delimiter, static_cast<std::size_t>(end - begin));
+    return {begin, static_cast<std::size_t>((stop == nullptr ? end : static_cast<const char*>(stop)) - begin)};
+}
+
+void countChunk(std::string_view chunk, const options& opts, tally_map& counts) {
+    std::size_t begin = 0;
+    while (begin < chunk.size()) {
+        std::size_t end = chunk.find('\n', begin);
+        if (end == std::string_view::npos) {
+            end = chunk.size();
+        }
+        std::string_view line = chunk.substr(begin, end - begin);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        begin = end + 1;
+
+        // Blank lines carry no value, as with cut and awk
+        if (line.empty()) {
+            continue;
+        }
+        const std::string_view token = selectField(line, opts.field, opts.delimiter);
+        if (token.data() != nullptr) {
+            counts[token]++;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const options opts = parseOptions(argc, argv);
+
+    try {
+        // Mappings stay alive until the end, since the counted keys view into them
+        std::vector<std::unique_ptr<mapped_file>> files;
+        std::vector<std::string_view> chunks;
+        for (const auto& path : opts.files) {
+            files.push_back(std::make_unique<mapped_file>(path));
+            splitLines(files.back()->view(), chunks);
+        }
+
+        std::size_t threads = opts.threads != 0 ? opts.threads : std::max(1u, std::thread::hardware_concurrency());
+        threads = std::max<std::size_t>(1, std::min(threads, chunks.size()));
+        std::vector<std::unique_ptr<count_map>> counts(threads);
+        std::vector<std::exception_ptr> errors(threads);
+        std::atomic<std::size_t> nextChunk{0};
+
+        auto work = [&](std::size_t worker) {
+            try {
+                tally_map tally;
+                for (std::size_t c = nextChunk++; c < chunks.size(); c = nextChunk++) {
+                    countChunk(chunks[c], opts, tally);
+                }
+                counts[worker] = std::make_unique<count_map>(tally.begin(), tally.end(), 1);
+            }
+            catch (...) {
+                errors[worker] = std::current_exception();
+            }
+        };
+        std::vector<std::thread> workers;
+        for (std::size_t w = 1; w < threads; w++) {
+            workers.emplace_back(work, w);
+        }
+        work(0);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Fold every other map into the first, one move per key
+        count_map& total = *counts[0];
+        for (std::size_t w = 1; w < threads; w++) {
+            for (const auto& [key, count] : counts[w]->top_k(counts[w]->size())) {
+                const std::size_t* found = total.find(key);
+                total.assign(key, found != nullptr ? *found + count : count);
+            }
+            counts[w].reset();
+        }
+
+        for (const auto& [key, count] : total.top_k(opts.k)) {
+            std::printf("%zu\t%.*s\n", count, static_cast<int>(key.size()), key.data());
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "pmap-topk: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}